@@ -0,0 +1,155 @@
+# Profile-guided + link-time optimized build of task_simulator.
+#
+# Run through the task_simulator_pgo target. Stages, all under WORK_DIR:
+#   baseline/   plain Release build, also used to generate training workloads
+#   workloads/  chain, ping_pong, fan_out and ram_contended training experiments
+#   held_out/   the same kinds at other sizes and host counts, never trained on
+#   optimized/  instrumented build, trained on the workloads, then rebuilt
+#               in place with the profile and LTO
+# Finally both binaries run both sets and the speedup is reported per set;
+# the held-out figure is the one to trust.
+
+cmake_minimum_required(VERSION 3.15)
+
+foreach(var SOURCE_DIR WORK_DIR CXX_COMPILER)
+    if(NOT ${var})
+        message(FATAL_ERROR "PGOBuild.cmake requires -D${var}=...")
+    endif()
+endforeach()
+
+set(common_args
+    -DCMAKE_BUILD_TYPE=Release
+    -DCMAKE_CXX_COMPILER=${CXX_COMPILER}
+    -DTASK_SIMULATOR_BUILD_TESTS=OFF
+)
+foreach(var SIMCPP20_INCLUDE_DIR tinyxml2_DIR spdlog_DIR)
+    if(${var})
+        list(APPEND common_args -D${var}=${${var}})
+    endif()
+endforeach()
+
+set(profile_dir ${WORK_DIR}/profiles)
+set(workload_dir ${WORK_DIR}/workloads)
+set(held_out_dir ${WORK_DIR}/held_out)
+
+function(run_checked)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        string(REPLACE ";" " " command "${ARGN}")
+        message(FATAL_ERROR "Command failed (${result}): ${command}")
+    endif()
+endfunction()
+
+function(build_tree dir)
+    run_checked(${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${dir} ${common_args} ${ARGN})
+    run_checked(${CMAKE_COMMAND} --build ${dir} --target task_simulator)
+endfunction()
+
+# Stage 1: baseline build
+message(STATUS "[PGO] Building baseline")
+build_tree(${WORK_DIR}/baseline -DTASK_SIMULATOR_LTO=OFF -DTASK_SIMULATOR_PGO=)
+set(baseline_bin ${WORK_DIR}/baseline/task_simulator)
+
+# Stage 2: representative training workloads (kind tasks hosts)
+set(workloads
+    "chain 200000 16"
+    "ping_pong 200000 16"
+    "fan_out 200000 32"
+    "ram_contended 100000 8"
+)
+# Benchmark-only workloads: other task counts and host counts change the
+# DAG shapes, queue lengths and link fan-out the profile saw
+set(held_out_workloads
+    "chain 300000 24"
+    "ping_pong 100000 8"
+    "fan_out 300000 12"
+    "ram_contended 150000 16"
+)
+message(STATUS "[PGO] Generating training and held-out workloads")
+foreach(workload ${workloads})
+    separate_arguments(workload_args UNIX_COMMAND "${workload}")
+    run_checked(${baseline_bin} generate ${workload_args} ${workload_dir})
+endforeach()
+foreach(workload ${held_out_workloads})
+    separate_arguments(workload_args UNIX_COMMAND "${workload}")
+    run_checked(${baseline_bin} generate ${workload_args} ${held_out_dir})
+endforeach()
+
+# Stage 3: instrumented build and training runs
+message(STATUS "[PGO] Building instrumented binary")
+file(REMOVE_RECURSE ${profile_dir})
+file(MAKE_DIRECTORY ${profile_dir})
+set(optimized_dir ${WORK_DIR}/optimized)
+build_tree(${optimized_dir} -DTASK_SIMULATOR_LTO=ON -DTASK_SIMULATOR_PGO=generate
+    -DTASK_SIMULATOR_PGO_DIR=${profile_dir})
+
+message(STATUS "[PGO] Training")
+foreach(workload ${workloads})
+    separate_arguments(workload_args UNIX_COMMAND "${workload}")
+    list(GET workload_args 0 kind)
+    run_checked(${optimized_dir}/task_simulator ${workload_dir}/${kind}.xml -e ${kind} --quiet)
+endforeach()
+
+if(CXX_COMPILER_ID MATCHES "Clang")
+    if(NOT LLVM_PROFDATA)
+        message(FATAL_ERROR "llvm-profdata is required for Clang PGO")
+    endif()
+    file(GLOB raw_profiles ${profile_dir}/*.profraw)
+    run_checked(${LLVM_PROFDATA} merge -output=${profile_dir}/task_simulator.profdata ${raw_profiles})
+endif()
+
+# Stage 4: rebuild the same tree with the profile
+message(STATUS "[PGO] Building optimized binary")
+build_tree(${optimized_dir} -DTASK_SIMULATOR_LTO=ON -DTASK_SIMULATOR_PGO=use
+    -DTASK_SIMULATOR_PGO_DIR=${profile_dir})
+
+# Stage 5: benchmark baseline vs optimized (best of 3 runs per workload)
+if(CMAKE_VERSION VERSION_LESS 3.23)
+    message(STATUS "[PGO] CMake >= 3.23 needed for sub-second timing, skipping benchmark")
+    message(STATUS "[PGO] Optimized binary: ${optimized_dir}/task_simulator")
+    return()
+endif()
+
+function(best_time_us binary dir kind out_var)
+    set(best "")
+    foreach(run RANGE 1 3)
+        string(TIMESTAMP start "%s%f")
+        run_checked(${binary} ${dir}/${kind}.xml -e ${kind} --quiet)
+        string(TIMESTAMP end "%s%f")
+        math(EXPR elapsed "${end} - ${start}")
+        if(best STREQUAL "" OR elapsed LESS best)
+            set(best ${elapsed})
+        endif()
+    endforeach()
+    set(${out_var} ${best} PARENT_SCOPE)
+endfunction()
+
+# Best-of-3 times of both binaries on the workloads in `dir`
+function(benchmark title dir)
+    message(STATUS "[PGO] ${title} (best of 3, milliseconds)")
+    message(STATUS "[PGO]   workload         baseline   optimized   speedup")
+    set(total_baseline 0)
+    set(total_optimized 0)
+    foreach(workload ${ARGN})
+        separate_arguments(workload_args UNIX_COMMAND "${workload}")
+        list(GET workload_args 0 kind)
+        best_time_us(${baseline_bin} ${dir} ${kind} baseline_us)
+        best_time_us(${optimized_dir}/task_simulator ${dir} ${kind} optimized_us)
+        math(EXPR total_baseline "${total_baseline} + ${baseline_us}")
+        math(EXPR total_optimized "${total_optimized} + ${optimized_us}")
+
+        math(EXPR baseline_ms "${baseline_us} / 1000")
+        math(EXPR optimized_ms "${optimized_us} / 1000")
+        math(EXPR speedup_pct "(${baseline_us} - ${optimized_us}) * 100 / ${baseline_us}")
+        string(LENGTH "${kind}" kind_length)
+        math(EXPR pad "16 - ${kind_length}")
+        string(REPEAT " " ${pad} padding)
+        message(STATUS "[PGO]   ${kind}${padding} ${baseline_ms}       ${optimized_ms}       ${speedup_pct}%")
+    endforeach()
+    math(EXPR total_speedup_pct "(${total_baseline} - ${total_optimized}) * 100 / ${total_baseline}")
+    message(STATUS "[PGO] ${title}: wall time reduced by ${total_speedup_pct}%")
+endfunction()
+
+benchmark("Training workloads" ${workload_dir} ${workloads})
+benchmark("Held-out workloads" ${held_out_dir} ${held_out_workloads})
+message(STATUS "[PGO] Optimized binary: ${optimized_dir}/task_simulator")
@@ -0,0 +1,56 @@
+// Aggregates over columnar task row files: utilization windows, wait-time
+// histograms and per-host percentiles
+
+#pragma once
+
+#include "executor.hpp"
+#include "task_rows.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace simulator {
+
+// Nearest-rank percentiles of one per-task duration
+struct Percentiles {
+    int64_t p50 = 0;
+    int64_t p90 = 0;
+    int64_t p99 = 0;
+    int64_t max = 0;
+};
+
+struct HostTraceStats {
+    std::string name;
+    uint64_t tasks = 0;
+    int64_t busy = 0;                  // Core time: sum of finish - start
+    Percentiles queue;                 // start - ready: waiting for RAM and a core
+    Percentiles response;              // finish - ready
+    std::vector<int64_t> window_busy;  // Core time in each utilization window
+};
+
+// Log2 histogram of one wait column: bucket 0 counts zeros, bucket b the
+// values in [2^(b-1), 2^b)
+struct WaitHistogram {
+    std::string name;
+    std::array<uint64_t, 65> buckets{};
+    int64_t total = 0;
+    int64_t max = 0;
+};
+
+struct TraceAnalysis {
+    uint64_t rows = 0;
+    int64_t makespan = 0;                // Last finish
+    int64_t window = 0;                  // Width of a utilization window
+    std::vector<WaitHistogram> waits;    // Dependency, link, transfer, RAM and CPU waits
+    std::vector<HostTraceStats> hosts;   // In file order
+};
+
+// Scan the columns in blocks on `pool`: each block is reduced on its own
+// and the partial results are merged, so the scan scales with the workers.
+// The makespan is split into at most `windows` windows of equal width.
+TraceAnalysis analyze_task_rows(const TaskRowData& data, size_t windows, WorkStealingPool& pool);
+
+std::string format_analysis(const TraceAnalysis& analysis);
+
+} // namespace simulator
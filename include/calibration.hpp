@@ -0,0 +1,91 @@
+// Calibration of host speeds and link scales against observed task timings
+
+#pragma once
+
+#include "executor.hpp"
+#include "models.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace simulator {
+
+// Start and finish of one task as observed on the cluster
+struct ObservedTask {
+    std::string name;
+    int64_t start = 0;
+    int64_t finish = 0;
+};
+
+// Read the TASK_NAME, START and FINISH columns of a CSV log. Lines before
+// the header are skipped, so result files can be read as well.
+std::vector<ObservedTask> parse_observed_log(const std::string& path);
+
+struct CalibrationOptions {
+    size_t max_iterations = 20;  // Levenberg-Marquardt iterations over the link scales
+    double step = 0.05;          // Smallest finite difference step on log(scale)
+};
+
+struct HostFit {
+    std::string name;
+    size_t tasks = 0;  // Observed executions on the host
+    double speed_before = 1.0;
+    double speed_after = 1.0;
+};
+
+struct LinkFit {
+    std::string from;
+    std::string to;
+    size_t transfers = 0;  // Dependencies with a transfer over the link
+    double scale_before = 1.0;
+    double scale_after = 1.0;
+};
+
+// Simulated minus observed times of the matched tasks, both measured from
+// their earliest start
+struct ResidualStats {
+    double start_rmse = 0.0;
+    double finish_rmse = 0.0;
+    double finish_bias = 0.0;  // Mean finish residual
+    int64_t finish_max = 0;    // Largest |finish residual|
+    int64_t makespan_simulated = 0;
+    int64_t makespan_observed = 0;
+};
+
+struct TaskResidual {
+    std::string name;
+    int64_t observed_start = 0;
+    int64_t simulated_start = 0;
+    int64_t observed_finish = 0;
+    int64_t simulated_finish = 0;
+};
+
+struct Calibration {
+    models::ExperimentConfig config;  // With the fitted speeds and link scales
+    std::vector<HostFit> hosts;       // Sorted by name
+    std::vector<LinkFit> links;       // Sorted by (from, to)
+    size_t matched_tasks = 0;
+    size_t unmatched_observations = 0;  // Log rows naming no task of the workload
+    size_t iterations = 0;
+    size_t simulations = 0;
+    ResidualStats before;
+    ResidualStats after;
+    std::vector<TaskResidual> residuals;  // After the fit, in task order
+};
+
+// Fit by least squares in two stages. Host speeds come in closed form from
+// the observed execution times (finish - start), which do not depend on the
+// schedule. Link scales show in the gap between a task's start and its
+// last dependency's finish (transfer plus queueing), so they are fitted by
+// Levenberg-Marquardt on the gap residuals of full simulations; the
+// finite-difference columns and the damping candidates of each iteration
+// run in parallel on `pool`.
+Calibration calibrate(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+                      const std::vector<ObservedTask>& observed, const CalibrationOptions& options,
+                      WorkStealingPool& pool);
+
+void write_residuals_csv(const std::string& path, const Calibration& calibration);
+
+std::string format_calibration(const Calibration& calibration);
+
+} // namespace simulator
@@ -18,6 +18,11 @@ models::ExperimentConfig get_experiment_config(
     const std::unordered_map<std::string, models::ExperimentConfig>& configs,
     const std::string& config_name);
 
+// Write experiment configurations in the format accepted by load_experiments_from_xml.
+// Relative tasks CSV paths are kept as given (resolved against the XML directory on load).
+void write_experiments_xml(const std::string& xml_path,
+                           const std::unordered_map<std::string, models::ExperimentConfig>& configs);
+
 } // namespace parsers
 
 #endif // CONFIG_PARSER_H_
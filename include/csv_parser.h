@@ -4,14 +4,22 @@
 #define CSV_PARSER_H_
 
 #include "models.h"
+#include <istream>
 #include <vector>
 #include <string>
 
 namespace parsers {
 
-// Parse tasks from a CSV file
+// Parse tasks from a CSV file; gzip and zstd files (detected by magic
+// bytes) are decompressed while parsing
 std::vector<models::Task> parse_tasks_csv(const std::string& csv_path);
 
+// Parse tasks from CSV text
+std::vector<models::Task> parse_tasks_csv(std::istream& input);
+
+// Write tasks back in the CSV format accepted by parse_tasks_csv
+void write_tasks_csv(const std::string& csv_path, const std::vector<models::Task>& tasks);
+
 // Validate that all task dependencies exist and there are no circular dependencies
 void validate_task_dependencies(const std::vector<models::Task>& tasks);
 
@@ -0,0 +1,43 @@
+// Streaming decompression of compressed task inputs
+
+#ifndef DECOMPRESS_H_
+#define DECOMPRESS_H_
+
+#include <istream>
+#include <memory>
+#include <string>
+
+namespace parsers {
+
+enum class Compression {
+    None,
+    Gzip,
+    Zstd
+};
+
+const char* to_string(Compression compression);
+
+// Detect the compression format from the file's magic bytes
+Compression detect_compression(const std::string& path);
+
+class DecompressingBuffer;
+
+// Input stream over a compressed file. A background thread decompresses
+// fixed-size chunks and hands them to the reader through a bounded queue,
+// so decompression overlaps with parsing and nothing is written to disk.
+class DecompressingStream : public std::istream {
+public:
+    DecompressingStream(const std::string& path, Compression compression);
+    ~DecompressingStream() override;
+
+    // Throw the decompression error (corrupt or truncated input), if any,
+    // that ended the stream early. Call once reading stops.
+    void check() const;
+
+private:
+    std::unique_ptr<DecompressingBuffer> buffer_;
+};
+
+} // namespace parsers
+
+#endif // DECOMPRESS_H_
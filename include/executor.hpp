@@ -0,0 +1,113 @@
+// Work-stealing thread pool shared by the batch, sweep and replication modes
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace simulator {
+
+// Each worker owns a deque: it pushes and pops its own jobs at the back and,
+// when empty, steals the oldest job from the front of another worker's
+// deque. Independent simulations differ in cost by orders of magnitude, so
+// stealing keeps every worker busy until the last job has started.
+class WorkStealingPool {
+public:
+    struct WorkerStats {
+        uint64_t jobs = 0;                 // Jobs run by this worker
+        uint64_t steals = 0;               // Of which taken from another worker
+        std::chrono::nanoseconds busy{0};  // Time spent running jobs
+    };
+
+    // 0 threads = one per hardware thread
+    explicit WorkStealingPool(size_t num_threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    // Run job(i) for i in [0, n) and return the results in index order,
+    // whatever order the jobs finish in. If jobs throw, the exception of the
+    // lowest index is rethrown once all jobs are done. May be called from
+    // inside a job: the calling worker runs queued jobs while it waits.
+    template <typename Result, typename Job>
+    std::vector<Result> map(size_t n, Job job);
+
+    // Per worker statistics since construction (or the last reset_stats())
+    std::vector<WorkerStats> stats() const;
+    void reset_stats();
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+        WorkerStats stats;  // Guarded by mutex
+    };
+
+    // Tracks the outstanding jobs of one map() call
+    struct Batch {
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining = 0;
+
+        void finish_one();
+    };
+
+    void submit(std::function<void()> job);
+    bool run_one(size_t self);
+    void wait(Batch& batch);
+    void worker_loop(size_t self);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_worker_{0};  // Round robin for outside submissions
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    int64_t queued_ = 0;  // Jobs in any deque, guarded by wake_mutex_
+    bool stopping_ = false;
+};
+
+template <typename Result, typename Job>
+std::vector<Result> WorkStealingPool::map(size_t n, Job job) {
+    std::vector<std::optional<Result>> results(n);
+    std::vector<std::exception_ptr> errors(n);
+    Batch batch;
+    batch.remaining = n;
+
+    for (size_t i = 0; i < n; ++i) {
+        submit([&, i] {
+            try {
+                results[i].emplace(job(i));
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+            batch.finish_one();
+        });
+    }
+    wait(batch);
+
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    std::vector<Result> ordered;
+    ordered.reserve(n);
+    for (auto& result : results) {
+        ordered.push_back(std::move(*result));
+    }
+    return ordered;
+}
+
+} // namespace simulator
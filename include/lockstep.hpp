@@ -0,0 +1,42 @@
+// Lockstep replications: straggler draws of one workload replayed together,
+// one replication per lane of every per-task time
+
+#pragma once
+
+#include "models.h"
+#include "simulator.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace simulator {
+
+// Replications replayed together. Every per-task time is an array of this
+// many lanes, so each step of the replay is a few vectorizable loops
+inline constexpr size_t kLockstepLanes = 8;
+
+struct Replication {
+    uint64_t seed = 0;       // Straggler seed of the replication
+    int64_t makespan = 0;
+    int64_t busy_time = 0;   // Core time of all executions
+    bool lockstep = false;   // Replayed; false if it diverged and ran on the engine
+    std::vector<TaskRecord> records;  // Replayed records carry ready, start and finish
+};
+
+// Whether replications of the experiment can run in lockstep: FIFO
+// admission, no speculation, autoscaling or pipelined dependencies
+bool supports_lockstep(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks);
+
+// Run `replications` replications with straggler seeds config.stragglers.seed,
+// seed + 1, ... in groups of kLockstepLanes. The first replication of a
+// group runs on the engine and logs its link and core grants. All lanes
+// then replay that grant order at once: a transfer starts when the link is
+// free, a task takes its host's earliest free core. A lane is kept only if
+// the order is one the engine could have chosen for it: requests to each
+// link and host arrive in logged order, a tie never decides who waits, and
+// RAM never makes a task wait. Other lanes run on the engine on their own,
+// so every result equals the engine's schedule.
+std::vector<Replication> run_lockstep(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+                                      size_t replications);
+
+} // namespace simulator
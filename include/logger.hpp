@@ -24,6 +24,11 @@ inline void set_level(spdlog::level::level_enum level) {
     spdlog::set_level(level);
 }
 
+// Flush buffered output (e.g. before exiting without running destructors)
+inline void flush() {
+    spdlog::default_logger()->flush();
+}
+
 // Logging functions using fmt::format
 template<typename... Args>
 inline void trace(fmt::format_string<Args...> fmt, Args&&... args) {
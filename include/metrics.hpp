@@ -0,0 +1,35 @@
+// Prometheus textfile export of live engine and cluster metrics
+
+#pragma once
+
+#include "progress.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace simulator {
+
+// Resident set size of this process in bytes (0 if unavailable)
+int64_t current_rss_bytes();
+
+// Render a counters snapshot in the Prometheus text exposition format
+std::string format_prometheus(const CountersSnapshot& snapshot, int64_t rss_bytes);
+
+// Periodically rewrites a node_exporter textfile-collector file. Each
+// rewrite goes to a temporary file renamed over the target, so scrapers
+// never observe a partially written file.
+class MetricsExporter {
+public:
+    MetricsExporter(const EngineCounters& counters, std::string path,
+                    std::chrono::milliseconds interval);
+
+    // Write the file once, synchronously
+    void write_now();
+
+private:
+    const EngineCounters& counters_;
+    std::string path_;
+    PeriodicSampler sampler_;  // Last member: its thread uses the fields above
+};
+
+} // namespace simulator
@@ -3,6 +3,8 @@
 #ifndef MODELS_H_
 #define MODELS_H_
 
+#include <cmath>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -22,12 +24,22 @@ struct Task {
     std::vector<size_t> dependency_indices;
     size_t index;
     size_t host_index;
+    std::string scaling_class{};  // Optional speed class, empty = host default speed
+    std::string group{};          // Optional job group for fair sharing, empty = default group
+    int pipeline_chunks = 0;      // Dependency outputs stream in this many chunks, <= 1 = wait for completion
+    int exec_time = 0;            // run_time scaled by host speed, resolved at init
+    size_t group_index = 0;       // Resolved at init
 
     // Check if task has dependencies
     bool has_dependency() const {
         return !dependency_indices.empty();
     }
 
+    // Consumes its dependencies' outputs while they are produced
+    bool pipelined() const {
+        return pipeline_chunks > 1;
+    }
+
 
     // Validate task parameters
     void validate() const {
@@ -43,6 +55,9 @@ struct Task {
         if (network_time < 0) {
             throw std::invalid_argument("Network time must be >= 0, got " + std::to_string(network_time));
         }
+        if (pipeline_chunks < 0) {
+            throw std::invalid_argument("Pipeline chunks must be >= 0, got " + std::to_string(pipeline_chunks));
+        }
     }
 };
 
@@ -50,6 +65,8 @@ struct Task {
 struct HostConfig {
     int cpu_cores;
     int ram;
+    double speed = 1.0;  // Relative CPU speed, run_time is divided by it
+    std::unordered_map<std::string, double> class_speeds{};  // Per scaling class overrides
 
     void validate() const {
         if (cpu_cores <= 0) {
@@ -58,6 +75,140 @@ struct HostConfig {
         if (ram <= 0) {
             throw std::invalid_argument("RAM must be > 0, got " + std::to_string(ram));
         }
+        if (speed <= 0.0) {
+            throw std::invalid_argument("Speed must be > 0, got " + std::to_string(speed));
+        }
+        for (const auto& [class_name, class_speed] : class_speeds) {
+            if (class_speed <= 0.0) {
+                throw std::invalid_argument("Speed for class '" + class_name + "' must be > 0, got " +
+                                            std::to_string(class_speed));
+            }
+        }
+    }
+};
+
+enum class SlowdownDistribution {
+    Fixed,    // Always `min`
+    Uniform,  // Uniform in [min, max]
+    Pareto    // Pareto with scale `min` and shape `alpha` (heavy tail)
+};
+
+// Seeded straggler injection: each task execution is slowed with
+// `probability` by a factor drawn from the slowdown distribution
+struct StragglerConfig {
+    double probability = 0.0;
+    uint64_t seed = 1;
+    SlowdownDistribution distribution = SlowdownDistribution::Fixed;
+    double min = 2.0;
+    double max = 2.0;
+    double alpha = 2.0;
+
+    // Slowdown factor at quantile `u` in [0, 1) of the distribution
+    double slowdown_at(double u) const {
+        switch (distribution) {
+            case SlowdownDistribution::Uniform: return min + u * (max - min);
+            case SlowdownDistribution::Pareto: return min / std::pow(1.0 - u, 1.0 / alpha);
+            case SlowdownDistribution::Fixed: break;
+        }
+        return min;
+    }
+
+    void validate() const {
+        if (probability < 0.0 || probability > 1.0) {
+            throw std::invalid_argument("Straggler probability must be in [0, 1], got " +
+                                        std::to_string(probability));
+        }
+        if (min < 1.0) {
+            throw std::invalid_argument("Straggler slowdown must be >= 1, got " + std::to_string(min));
+        }
+        if (distribution == SlowdownDistribution::Uniform && max < min) {
+            throw std::invalid_argument("Straggler slowdown max must be >= min, got " + std::to_string(max));
+        }
+        if (distribution == SlowdownDistribution::Pareto && alpha <= 0.0) {
+            throw std::invalid_argument("Straggler Pareto alpha must be > 0, got " + std::to_string(alpha));
+        }
+    }
+};
+
+// Speculative execution: a task still running after the given percentile
+// of its expected runtime distribution gets a backup copy on another host
+struct SpeculationConfig {
+    bool enabled = false;
+    double percentile = 95.0;
+
+    void validate() const {
+        if (percentile <= 0.0 || percentile >= 100.0) {
+            throw std::invalid_argument("Speculation percentile must be in (0, 100), got " +
+                                        std::to_string(percentile));
+        }
+    }
+};
+
+// How a host picks the next waiting task for its RAM and cores
+enum class AdmissionPolicy {
+    Fifo,  // RAM, then a core, each in arrival order
+    Drf    // Dominant Resource Fairness across task groups
+};
+
+// How a directional link serializes transfers
+enum class LinkModel {
+    Resource,  // Capacity-1 simulation resource: a request event per transfer
+    Clock      // Busy flag and FIFO: no request event for transfers that find the link free
+};
+
+// Elastic host pool. Tasks whose host is `pool` run on pool hosts that are
+// added and drained during the run: every `interval` time units the policy
+// compares the pool's queue (tasks waiting for a pool host, RAM or a core)
+// and core utilization with its thresholds, at most once per `cooldown`.
+// New hosts take `provisioning_delay` to become usable. An empty pool with
+// pending tasks always gets a host.
+struct AutoscalingConfig {
+    bool enabled = false;
+    std::string pool = "POOL";        // Task host name, pool hosts are named <pool>_<n>
+    HostConfig host{4, 10000};        // Every pool host
+    size_t min_hosts = 1;
+    size_t max_hosts = 8;
+    size_t initial_hosts = 1;         // Usable at time 0
+    int64_t interval = 10;
+    int64_t cooldown = 0;             // After the last scaling action
+    int64_t provisioning_delay = 0;
+    double scale_up_queue = 0.0;        // Waiting tasks per pool host to add one, 0 = off
+    double scale_up_utilization = 0.0;  // Busy core fraction to add a host, 0 = off
+    double scale_down_utilization = 0.0;  // Drain a host at or below this with nothing queued
+
+    void validate() const {
+        host.validate();
+        if (max_hosts == 0 || min_hosts > max_hosts) {
+            throw std::invalid_argument("Autoscaling needs 0 <= min <= max and max > 0, got min " +
+                                        std::to_string(min_hosts) + ", max " + std::to_string(max_hosts));
+        }
+        if (initial_hosts < min_hosts || initial_hosts > max_hosts) {
+            throw std::invalid_argument("Autoscaling initial hosts must be in [min, max], got " +
+                                        std::to_string(initial_hosts));
+        }
+        if (interval <= 0 || cooldown < 0 || provisioning_delay < 0) {
+            throw std::invalid_argument("Autoscaling interval must be > 0, cooldown and provisioning delay >= 0");
+        }
+        if (scale_up_queue < 0.0 || scale_up_utilization < 0.0 || scale_up_utilization > 1.0 ||
+            scale_down_utilization < 0.0 || scale_down_utilization > 1.0) {
+            throw std::invalid_argument("Autoscaling queue threshold must be >= 0, utilization thresholds in [0, 1]");
+        }
+    }
+};
+
+// Factor on the network_time of outputs sent over one directed link
+struct LinkScale {
+    std::string from;
+    std::string to;
+    double scale = 1.0;
+
+    void validate() const {
+        if (from.empty() || to.empty() || from == to) {
+            throw std::invalid_argument("Link scale needs two different hosts, got '" + from + "' -> '" + to + "'");
+        }
+        if (scale <= 0.0) {
+            throw std::invalid_argument("Link scale must be > 0, got " + std::to_string(scale));
+        }
     }
 };
 
@@ -65,9 +216,15 @@ struct HostConfig {
 struct ExperimentConfig {
     std::unordered_map<std::string, HostConfig> hosts;
     std::string tasks_csv_path;  // Path to CSV file with tasks
+    StragglerConfig stragglers;
+    SpeculationConfig speculation;
+    AdmissionPolicy admission = AdmissionPolicy::Fifo;
+    LinkModel link_model = LinkModel::Resource;
+    AutoscalingConfig autoscaling;
+    std::vector<LinkScale> link_scales;  // Links without an entry use 1.0
 
     void validate(bool validate_hosts=false) const {
-        if (hosts.empty()) {
+        if (hosts.empty() && !autoscaling.enabled) {
             throw std::invalid_argument("Experiment configuration must have at least one host");
         }
         if (tasks_csv_path.empty()) {
@@ -78,6 +235,9 @@ struct ExperimentConfig {
                 host_config.validate();
             }
         }
+        for (const auto& link : link_scales) {
+            link.validate();
+        }
     }
 };
 
@@ -0,0 +1,104 @@
+// Live engine counters and background progress reporting
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace simulator {
+
+// Single-writer increment/decrement: a load and a store, no read-modify-write
+template <typename T>
+inline void bump(std::atomic<T>& counter, T delta = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+// Per-host resource gauges published by the simulation thread
+struct HostCounters {
+    std::string name;        // Set once at init, read-only afterwards
+    int cpu_cores = 0;
+    std::atomic<int64_t> cpu_busy{0};
+    std::atomic<int64_t> cpu_waiting{0};
+    std::atomic<int64_t> ram_level{0};
+    std::atomic<int64_t> ram_waiting{0};
+};
+
+// Counters published by the simulation thread. The engine only performs
+// relaxed stores; samplers on other threads read them with relaxed loads.
+struct EngineCounters {
+    std::atomic<int64_t> sim_time{0};
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> tasks_completed{0};
+    std::atomic<uint64_t> tasks_total{0};
+    std::atomic<bool> finished{false};
+    std::vector<HostCounters> hosts;  // Sized at init, before any sampler starts
+};
+
+struct HostSnapshot {
+    std::string name;
+    int cpu_cores = 0;
+    int64_t cpu_busy = 0;
+    int64_t cpu_waiting = 0;
+    int64_t ram_level = 0;
+    int64_t ram_waiting = 0;
+};
+
+// Plain copy of the counters taken at one point in wall time
+struct CountersSnapshot {
+    std::chrono::steady_clock::time_point taken_at;
+    int64_t sim_time = 0;
+    uint64_t events = 0;
+    uint64_t tasks_completed = 0;
+    uint64_t tasks_total = 0;
+    bool finished = false;
+    std::vector<HostSnapshot> hosts;
+};
+
+CountersSnapshot take_snapshot(const EngineCounters& counters);
+
+// One progress line: simulated time, event rate, task completion and ETA
+std::string format_progress(const CountersSnapshot& previous, const CountersSnapshot& current);
+
+// Background thread calling a function every interval and once more on stop
+class PeriodicSampler {
+public:
+    PeriodicSampler(std::chrono::milliseconds interval, std::function<void()> tick);
+    ~PeriodicSampler();
+
+    PeriodicSampler(const PeriodicSampler&) = delete;
+    PeriodicSampler& operator=(const PeriodicSampler&) = delete;
+
+    void stop();
+
+private:
+    void loop();
+
+    std::chrono::milliseconds interval_;
+    std::function<void()> tick_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+// Periodically logs a progress line. Stops (and logs a final line) on destruction.
+class ProgressReporter {
+public:
+    ProgressReporter(const EngineCounters& counters, std::chrono::milliseconds interval);
+
+private:
+    void tick();
+
+    const EngineCounters& counters_;
+    CountersSnapshot previous_;
+    PeriodicSampler sampler_;  // Last member: its thread uses the fields above
+};
+
+} // namespace simulator
@@ -0,0 +1,72 @@
+// Run result files and run-to-run comparison
+
+#pragma once
+
+#include "models.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace simulator {
+
+class TaskSimulator;
+struct TaskRecord;
+
+// Critical path split into what it spent its time on; the parts add up to
+// the makespan
+struct CriticalPathComposition {
+    int64_t run = 0;       // Executing on a core
+    int64_t network = 0;   // Transfer (including link queueing) from a dependency
+    int64_t wait = 0;      // Waiting for RAM or a core without a known blocker
+    int64_t sleep = 0;     // Initial sleep of the first task on the path
+};
+
+// Walk back from the last task to finish. A task that waited for resources
+// continues through the same-host task whose release admitted it, otherwise
+// through the dependency that made it ready. Marks the tasks on the path.
+CriticalPathComposition critical_path(const std::vector<models::Task>& tasks,
+                                      const std::vector<TaskRecord>& records,
+                                      std::vector<bool>& on_path);
+
+// Write a result file: makespan, per-host utilization, critical-path
+// composition and one row per task sorted by task name, so two results can
+// be compared with a streaming merge join
+void write_result_file(const std::string& path, const TaskSimulator& sim);
+
+struct TaskFinishDelta {
+    std::string name;
+    int64_t finish_a = 0;
+    int64_t finish_b = 0;
+    int64_t delta() const { return finish_b - finish_a; }
+};
+
+struct HostUtilizationDelta {
+    std::string name;
+    double utilization_a = 0.0;  // Percent, 0 if the host is missing on that side
+    double utilization_b = 0.0;
+};
+
+struct ResultComparison {
+    int64_t makespan_a = 0;
+    int64_t makespan_b = 0;
+    std::vector<HostUtilizationDelta> hosts;
+    std::vector<TaskFinishDelta> largest_moves;  // Largest |delta| first
+    CriticalPathComposition critical_a;
+    CriticalPathComposition critical_b;
+    size_t matched_tasks = 0;
+    size_t only_in_a = 0;
+    size_t only_in_b = 0;
+    size_t joined_critical_path = 0;
+    size_t left_critical_path = 0;
+    std::vector<std::string> joined_critical_examples;
+    std::vector<std::string> left_critical_examples;
+};
+
+// Compare two result files by merging their name-sorted task rows. Memory
+// stays O(top_n + hosts) regardless of the number of tasks.
+ResultComparison compare_result_files(const std::string& path_a, const std::string& path_b,
+                                      size_t top_n = 10);
+
+std::string format_comparison(const ResultComparison& comparison);
+
+} // namespace simulator
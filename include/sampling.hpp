@@ -0,0 +1,49 @@
+// Sampled simulation of long repetitive workloads: detailed windows with
+// fast-forwarding in between, reported with confidence intervals
+
+#pragma once
+
+#include "executor.hpp"
+#include "models.h"
+#include <cstdint>
+#include <vector>
+
+namespace simulator {
+
+struct SamplingConfig {
+    size_t window = 1000;   // Tasks simulated in detail at the start of each period
+    size_t period = 10000;  // Tasks per period: one detailed window, the rest fast-forwarded
+    size_t warmup = 100;    // Tasks at either end of a window that fill or drain the hosts
+
+    void validate() const;
+};
+
+// Estimate with a 95% confidence interval (Student t over the windows;
+// low == high when there is a single window)
+struct Interval {
+    double estimate = 0.0;
+    double low = 0.0;
+    double high = 0.0;
+};
+
+struct SampledRun {
+    size_t tasks = 0;            // Tasks in the workload
+    size_t detailed_tasks = 0;   // Tasks simulated in detail
+    size_t windows = 0;
+    Interval makespan;
+    Interval utilization;        // Percent of the hosts' core time
+    std::vector<double> window_task_time;    // Time per finished task, steady part of each window
+    std::vector<double> window_utilization;  // Percent, steady part of each window
+};
+
+// Every period starts with a detailed window: its slice of the task list
+// runs on a TaskSimulator, with dependencies on tasks outside the slice
+// treated as satisfied. Between the warm-up and the drain, the window's
+// finish rate and busy core time give its throughput and utilization. The fast-forwarded
+// rest of the period is released at that throughput without modelling
+// resources. Windows are independent and run in parallel on `pool`.
+// Dependencies must point to earlier tasks, as in the generated workloads.
+SampledRun run_sampled(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+                       const SamplingConfig& sampling, WorkStealingPool& pool);
+
+} // namespace simulator
@@ -0,0 +1,200 @@
+// Semaphore class for SimCpp20 - a k-server resource for identical units
+// like CPU cores, granted without an event while a unit is free
+
+#pragma once
+
+#include <fschuetz04/simcpp20.hpp>
+#include <coroutine>
+#include <cstdint>
+#include <utility>
+
+namespace simcpp20 {
+
+/**
+ * A counting semaphore over `count` identical units.
+ *
+ * `co_await sem.acquire()` takes a free unit without suspending and without
+ * creating an event. Otherwise the awaiter itself, which lives in the
+ * awaiting coroutine's frame, is linked into an intrusive FIFO queue; a
+ * release hands its unit to the oldest waiter and resumes it through one
+ * event scheduled at the release, the slot a triggered request event would
+ * take. The acquired unit comes back as a `hold` that releases it when it
+ * is destroyed or released early.
+ *
+ * `request()` is the event form for callers that need to combine or abort
+ * the wait; they release the unit themselves.
+ *
+ * @tparam Time Type used for simulation time.
+ */
+template <typename Time = double>
+class semaphore {
+    /// Intrusive queue node.
+    struct waiter {
+        waiter* next = nullptr;
+        /// Hands the unit over; false if the waiter gave up (aborted request).
+        bool (*grant)(waiter&) = nullptr;
+    };
+
+public:
+    /// One acquired unit, released on destruction unless released or moved.
+    class hold {
+    public:
+        hold() = default;
+        explicit hold(semaphore& sem) : sem_{&sem} {}
+        hold(hold&& other) noexcept : sem_{std::exchange(other.sem_, nullptr)} {}
+        hold& operator=(hold&& other) noexcept {
+            if (this != &other) {
+                release();
+                sem_ = std::exchange(other.sem_, nullptr);
+            }
+            return *this;
+        }
+        hold(const hold&) = delete;
+        hold& operator=(const hold&) = delete;
+        ~hold() { release(); }
+
+        /// Release the unit now; no-op if already released.
+        void release() {
+            if (sem_) std::exchange(sem_, nullptr)->release();
+        }
+
+        explicit operator bool() const { return sem_ != nullptr; }
+
+    private:
+        semaphore* sem_ = nullptr;
+    };
+
+    /// Awaiter returned by acquire(); also the queue node while waiting.
+    class acquire_awaiter : waiter {
+    public:
+        explicit acquire_awaiter(semaphore& sem) : sem_{sem} { this->grant = &acquire_awaiter::grant_unit; }
+        acquire_awaiter(const acquire_awaiter&) = delete;
+        acquire_awaiter& operator=(const acquire_awaiter&) = delete;
+
+        bool await_ready() { return sem_.try_acquire(); }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            handle_ = handle;
+            sem_.push(this);
+        }
+
+        hold await_resume() { return hold{sem_}; }
+
+    private:
+        static bool grant_unit(waiter& node) {
+            auto& self = static_cast<acquire_awaiter&>(node);
+            auto resumed = self.sem_.sim_.event();
+            resumed.add_callback([handle = self.handle_](const event<Time>&) { handle.resume(); });
+            resumed.trigger();
+            return true;
+        }
+
+        semaphore& sem_;
+        std::coroutine_handle<> handle_;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param sim Reference to the simulation.
+     * @param count Number of units, all free.
+     */
+    semaphore(simulation<Time>& sim, uint64_t count) : sim_{sim}, available_{count} {}
+
+    semaphore(const semaphore&) = delete;
+    semaphore& operator=(const semaphore&) = delete;
+
+    ~semaphore() {
+        // Request nodes are owned here; awaiter nodes belong to their frames
+        while (head_) {
+            waiter* node = pop();
+            if (node->grant == &request_waiter::grant_unit) {
+                delete static_cast<request_waiter*>(node);
+            }
+        }
+    }
+
+    /// @return An awaiter resuming with a hold on one unit.
+    acquire_awaiter acquire() { return acquire_awaiter{*this}; }
+
+    /**
+     * Request one unit as an event.
+     *
+     * @return An event triggered once the unit is granted. Aborting it
+     *         withdraws the request; after it triggered the caller must
+     *         call release().
+     */
+    event<Time> request() {
+        auto ev = sim_.event();
+        if (try_acquire()) {
+            ev.trigger();
+        } else {
+            push(new request_waiter{ev});
+        }
+        return ev;
+    }
+
+    /// Take a unit if one is free. @return Whether one was taken.
+    bool try_acquire() {
+        if (available_ == 0) return false;
+        --available_;
+        return true;
+    }
+
+    /// Return a unit: to the oldest live waiter if there is one.
+    void release() {
+        while (head_) {
+            waiter* node = pop();
+            if (node->grant(*node)) return;
+        }
+        ++available_;
+    }
+
+    /// @return Number of free units.
+    uint64_t available() const { return available_; }
+
+private:
+    /// Queue node of an event request, allocated only when it has to wait.
+    struct request_waiter : waiter {
+        explicit request_waiter(event<Time> ev) : ev{std::move(ev)} { this->grant = &request_waiter::grant_unit; }
+
+        static bool grant_unit(waiter& node) {
+            auto* self = static_cast<request_waiter*>(&node);
+            bool live = self->ev.pending();
+            if (live) self->ev.trigger();
+            delete self;
+            return live;
+        }
+
+        event<Time> ev;
+    };
+
+    void push(waiter* node) {
+        node->next = nullptr;
+        if (tail_) {
+            tail_->next = node;
+        } else {
+            head_ = node;
+        }
+        tail_ = node;
+    }
+
+    waiter* pop() {
+        waiter* node = head_;
+        head_ = node->next;
+        if (!head_) tail_ = nullptr;
+        return node;
+    }
+
+    /// Reference to the simulation.
+    simulation<Time>& sim_;
+
+    /// Free units; zero whenever the queue is not empty.
+    uint64_t available_;
+
+    /// Waiters in arrival order.
+    waiter* head_ = nullptr;
+    waiter* tail_ = nullptr;
+};
+
+} // namespace simcpp20
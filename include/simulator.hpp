@@ -4,11 +4,21 @@
 
 #include <fschuetz04/simcpp20.hpp>
 #include "container.hpp"
+#include "semaphore.hpp"
 #include "models.h"
+#include "progress.hpp"
+#include "task_rows.hpp"
+#include "timeseries.hpp"
+#include <coroutine>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <unordered_map>
 #include <map>
+#include <queue>
+#include <set>
 #include <string>
 
 namespace simulator {
@@ -16,42 +26,375 @@ namespace simulator {
 // Represents a compute host with CPU cores and RAM resources
 struct Host {
     std::string name;
-    simcpp20::resource<> cpu;
+    simcpp20::semaphore<> cpu;
     simcpp20::container<> ram;
     int cpu_cores;
     int ram_capacity;
+    double speed;
+    std::unordered_map<std::string, double> class_speeds;
 
     Host(simcpp20::simulation<>& sim, const std::string& name,
-         int cpu_cores, int ram_capacity);
+         int cpu_cores, int ram_capacity, double speed = 1.0,
+         std::unordered_map<std::string, double> class_speeds = {});
+
+    // Time the task occupies a core on this host (run_time scaled by speed)
+    int execution_time(const models::Task& task) const;
 };
 
 using HostPtr = std::shared_ptr<Host>;
 
-// Represents a full-duplex network link between hosts
+// Represents a full-duplex network link between hosts. Each directional
+// link is created on its first use, so hosts can be added in O(1) and only
+// pairs that exchange data cost memory.
+//
+// A directional link is a capacity-1 FIFO held for exactly the transfer
+// time. Under LinkModel::Clock a transfer that finds the link free takes it
+// on arrival, without the request event of a resource; a queued one is
+// started by the completing transfer through one event at the release, the
+// slot its triggered request would take. Grants and completions keep the
+// resource's order, so both models give the same schedule, and only
+// transfers that do not queue save an event.
 class NetworkLink {
+    struct Clock;
+
 public:
-    // Constructor takes number of hosts to create links between all pairs
-    NetworkLink(simcpp20::simulation<>& sim, size_t num_hosts);
+    // Link clock: awaiter for one transfer, see transfer(). It is the queue
+    // node while waiting, so it lives in the awaiting coroutine's frame
+    class Transfer {
+    public:
+        Transfer(const Transfer&) = delete;
+        Transfer& operator=(const Transfer&) = delete;
+
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        // @return Time the transfer got the link
+        int64_t await_resume() const { return start_; }
+
+    private:
+        friend class NetworkLink;
+        Transfer(NetworkLink& network, Clock& clock, int64_t duration)
+            : network_{network}, clock_{clock}, duration_{duration} {}
+
+        // Take the link now and resume the awaiter when the transfer is done
+        void begin();
+
+        NetworkLink& network_;
+        Clock& clock_;
+        int64_t duration_;
+        int64_t start_ = 0;
+        std::coroutine_handle<> handle_;
+        Transfer* next_ = nullptr;
+    };
+
+    NetworkLink(simcpp20::simulation<>& sim, size_t num_hosts,
+                models::LinkModel model = models::LinkModel::Resource);
+
+    models::LinkModel model() const { return model_; }
 
     // Get the appropriate network link for the given direction
     simcpp20::resource<>* get_link(size_t from_host_index, size_t to_host_index);
 
+    // Link clock: hold the link in the given direction for `duration` after
+    // the transfers queued before it. co_await resumes once it completed
+    Transfer transfer(size_t from_host_index, size_t to_host_index, int64_t duration);
+
+    // Link clock: whether a transfer holds the link in the given direction
+    bool busy(size_t from_host_index, size_t to_host_index) const;
+
+    // Make index num_hosts() a valid link endpoint
+    void add_host() { ++num_hosts_; }
+
+    size_t num_hosts() const { return num_hosts_; }
+    size_t num_links() const { return links_.size() + clocks_.size(); }
+
+    // Scale the network_time of outputs sent from one host to another
+    void set_scale(size_t from_host_index, size_t to_host_index, double scale);
+
+    // Time to send an output taking `network_time` over the link
+    int64_t transfer_time(size_t from_host_index, size_t to_host_index, int64_t network_time) const;
+
 private:
+    // Link clock state of one direction: the holder's flag and the waiters
+    struct Clock {
+        bool busy = false;
+        Transfer* head = nullptr;
+        Transfer* tail = nullptr;
+    };
+
+    simcpp20::simulation<>& sim_;
+    size_t num_hosts_;
     // Map from host index pair to network resource
     std::map<std::pair<size_t, size_t>, std::unique_ptr<simcpp20::resource<>>> links_;
+    models::LinkModel model_;
+    std::unordered_map<uint64_t, Clock> clocks_;  // Link clock: keyed by from << 32 | to
+    std::map<std::pair<size_t, size_t>, double> scales_;  // Only links with a scale != 1
 };
 
 using NetworkLinkPtr = std::shared_ptr<NetworkLink>;
 
+// Dominant Resource Fairness admission on one host. Waiting tasks queue per
+// group; the head task of the group with the lowest dominant share (the
+// larger of its fractions of the host's cores and RAM) is admitted next and
+// gets its RAM and a core together. If it does not fit yet, later groups
+// wait as well. Groups with waiters are kept ordered by share, so each
+// admission and release costs O(log groups).
+class DrfAdmission {
+public:
+    DrfAdmission(simcpp20::simulation<>& sim, Host& host) : sim_(sim), host_(host) {}
+
+    // Event triggered once the task holds `ram` and a core
+    simcpp20::event<> admit(size_t group, int ram);
+
+    // Give back a core and `ram` held by a task of `group`
+    void release(size_t group, int ram);
+
+private:
+    struct Waiter {
+        int ram;
+        simcpp20::event<> admitted;
+    };
+    struct GroupState {
+        std::queue<Waiter> waiting;
+        int64_t cores = 0;
+        int64_t ram = 0;
+    };
+
+    double share(const GroupState& group) const;
+    void dispatch();
+
+    simcpp20::simulation<>& sim_;
+    Host& host_;
+    std::unordered_map<size_t, GroupState> groups_;  // Only groups seen on this host
+    std::set<std::pair<double, size_t>> order_;     // (share, group) of groups with waiters
+};
+
+// Elastic host pool (see models::AutoscalingConfig). Pool hosts are
+// appended to the simulator's host list as they are first needed and a
+// drained host's slot (index and name) is reused by a later scale-up, so
+// the list holds at most max_hosts pool hosts. Once its dependencies are
+// done, a pool task waits in one pending queue until a usable host has a
+// core not promised to another placed task, and goes to the least loaded
+// such host.
+class Autoscaler {
+public:
+    // `hosts` must have capacity for max_hosts more entries, so growing it
+    // never invalidates references held by task processes
+    Autoscaler(simcpp20::simulation<>& sim, const models::AutoscalingConfig& config,
+               std::vector<models::Task>& tasks, std::vector<HostPtr>& hosts,
+               NetworkLink& network, const EngineCounters& counters);
+
+    // Place a pool task (sets its host and host_index). If no pool host has
+    // room, returns an event triggered once the task has been placed;
+    // waiting tasks are placed in arrival order.
+    std::optional<simcpp20::event<>> place(size_t task_index);
+
+    // A placed task finished and gave back its resources
+    void release(size_t task_index);
+
+    // Apply the scaling policy once (see autoscaler_process)
+    void evaluate();
+
+    // All tasks completed
+    bool finished() const;
+
+    int64_t interval() const { return config_.interval; }
+
+    // Name of pool host slot n
+    std::string slot_name(size_t slot) const { return config_.pool + "_" + std::to_string(slot); }
+    size_t first_index() const { return first_index_; }
+
+    // Time host `host_index` was provisioned or running up to `end` (`end`
+    // for hosts outside the pool), and the sum over all pool hosts
+    int64_t host_time(size_t host_index, int64_t end) const;
+    int64_t pool_host_time(int64_t end) const;
+
+    uint64_t scale_ups() const { return scale_ups_; }
+    uint64_t scale_downs() const { return scale_downs_; }
+    size_t peak_hosts() const { return peak_hosts_; }
+
+private:
+    enum class SlotState { Provisioning, Active, Draining, Removed };
+    struct Slot {
+        SlotState state = SlotState::Removed;
+        int64_t since = 0;      // Requested at, while not removed
+        int64_t host_time = 0;  // Of earlier incarnations
+        size_t load = 0;        // Placed tasks not yet finished
+    };
+
+    bool place_now(size_t task_index);
+    void dispatch();  // Place waiting tasks while there is room
+    void add_host(bool immediately);
+    void activate(size_t slot);
+    void remove(size_t slot);
+    size_t live_hosts() const;  // Provisioning or active
+
+    simcpp20::simulation<>& sim_;
+    const models::AutoscalingConfig& config_;
+    std::vector<models::Task>& tasks_;
+    std::vector<HostPtr>& hosts_;
+    NetworkLink& network_;
+    const EngineCounters& counters_;
+    size_t first_index_;            // Host index of slot 0
+    std::vector<Slot> slots_;
+    std::deque<std::pair<size_t, simcpp20::event<>>> waiting_;  // Pending tasks, in arrival order
+    int64_t last_action_;
+    uint64_t scale_ups_ = 0;
+    uint64_t scale_downs_ = 0;
+    size_t peak_hosts_ = 0;
+};
+
+// Scaling policy loop: evaluates `autoscaler` every interval until all
+// tasks completed
+simcpp20::process<> autoscaler_process(simcpp20::simulation<>& sim, Autoscaler& autoscaler);
+
+// Approximate timing: timed waits end on multiples of the quantum and all
+// waits ending on the same multiple share one event. Each task process also
+// tracks its exact time, carried across dependencies and resource hand-overs,
+// and wakes on the multiple nearest to it, so rounding errors do not add up.
+class QuantumClock {
+public:
+    QuantumClock(simcpp20::simulation<>& sim, int64_t quantum, size_t num_tasks, size_t num_hosts);
+
+    // Event on the multiple of the quantum nearest to `exact_time`, never before now
+    simcpp20::event<> wait_until(int64_t exact_time);
+
+    int64_t quantum() const { return quantum_; }
+
+    // Distinct tick events scheduled so far
+    uint64_t ticks() const { return ticks_created_; }
+
+    // Exact-time estimates of task finishes and of the latest release of
+    // each resource, read by processes that waited on them
+    std::vector<int64_t> task_finish;
+    std::vector<int64_t> cpu_release;
+    std::vector<int64_t> ram_release;
+    std::unordered_map<const simcpp20::resource<>*, int64_t> link_release;
+
+private:
+    simcpp20::simulation<>& sim_;
+    int64_t quantum_;
+    std::unordered_map<int64_t, simcpp20::event<>> pending_;  // Tick time -> shared event
+    uint64_t ticks_created_ = 0;
+};
+
+// Ask the running simulation to log a state dump at its next safe point
+// (between two events). Async-signal-safe: only sets an atomic flag.
+void request_state_dump();
+
+// Install request_state_dump() as the SIGUSR1 handler
+void install_state_dump_handler();
+
+// Lifecycle phase of a task process, tracked for state dumps
+enum class TaskPhase {
+    Created,
+    Sleeping,
+    WaitingDependency,
+    WaitingLink,
+    Transferring,
+    WaitingRam,
+    WaitingCpu,
+    WaitingAdmission,  // RAM and a core together, under DRF
+    WaitingPlacement,  // For a usable autoscaled pool host
+    Running,
+    WaitingStream,     // Executed, waiting for the last chunk of a pipelined input
+    Done
+};
+
+const char* to_string(TaskPhase phase);
+
+// Per-task timings recorded during a run (-1 = not reached)
+struct TaskRecord {
+    int64_t ready = -1;   // Sleep done and dependencies delivered
+    int64_t start = -1;   // CPU acquired
+    int64_t finish = -1;  // Execution finished
+
+    TaskPhase phase = TaskPhase::Created;
+    int64_t phase_since = 0;   // Simulated time the current phase began
+    size_t peer = SIZE_MAX;    // Dependency waited on / transferred from
+
+    // Time spent in each waiting phase
+    int64_t dependency_wait = 0;
+    int64_t link_wait = 0;
+    int64_t transfer = 0;
+    int64_t ram_wait = 0;
+    int64_t cpu_wait = 0;      // Includes DRF admission and pool placement waits
+};
+
+// Canonical digest of a schedule: FNV-1a over task names with start and
+// finish times, in task order. Equal digests mean identical schedules.
+uint64_t trace_digest(const std::vector<models::Task>& tasks,
+                      const std::vector<TaskRecord>& records);
+
+// Straggler injection and speculative execution: per-task execution times
+// with the injected slowdown, the speculation threshold and run statistics
+struct StragglerState {
+    std::vector<int64_t> exec_time;  // Actual execution time on the task's host
+    double threshold = 0.0;          // Backup after threshold x expected time, 0 = off
+    uint64_t stragglers = 0;
+    int64_t slowdown_time = 0;       // Execution time added by the slowdown
+    uint64_t backups = 0;
+    uint64_t backups_won = 0;
+    uint64_t cancelled = 0;          // Copies stopped because the other one finished
+    int64_t wasted_time = 0;         // Core time spent by the losing copies
+};
+
+// Draw the per-task execution times of a run with stragglers: slowdowns
+// come per task in index order from a portable generator seeded with
+// `config.seed`, so a seed slows the same executions on every platform.
+// Expects resolved exec_time; leaves the speculation threshold at 0.
+StragglerState draw_stragglers(const models::StragglerConfig& config, const std::vector<models::Task>& tasks);
+
+// One resource grant, logged in the order the engine made it: the link
+// for the output of dependency `dep`, or a core when dep is kCoreGrant
+struct GrantStep {
+    static constexpr uint32_t kCoreGrant = UINT32_MAX;
+
+    uint32_t task;
+    uint32_t dep;
+    int64_t transfer;  // Transfer time of a link grant
+};
+
+// State of one run shared by all task processes
+struct SimulationContext {
+    const std::vector<models::Task>& tasks;
+    const std::vector<HostPtr>& hosts;
+    NetworkLinkPtr network;
+    std::vector<simcpp20::event<>>& task_completed;
+    std::vector<TaskRecord>& records;
+    EngineCounters& counters;
+    ResourceRecorder* recorder;  // nullptr unless time series are enabled
+    QuantumClock* quantum;       // nullptr for exact timing
+    TaskRowSink* rows;           // nullptr unless per-task output is enabled
+    StragglerState* stragglers;  // nullptr without stragglers and speculation
+    std::vector<DrfAdmission>* admission;  // Per host, nullptr for FIFO admission
+    Autoscaler* autoscaler;      // nullptr without an elastic pool
+    // Start events of producers of pipelined dependencies, nullptr without any
+    std::unordered_map<size_t, simcpp20::event<>>* task_started;
+    std::vector<GrantStep>* grants;  // nullptr unless grants are logged
+};
+
+// Per task group outcome of a run
+struct GroupStats {
+    std::string name;
+    size_t tasks = 0;
+    double throughput = 0.0;     // Tasks finished per time unit of the makespan
+    double mean_slowdown = 0.0;  // (finish - ready) / execution time, over tasks that run
+    double max_slowdown = 0.0;
+};
+
 // Task execution process (coroutine)
 simcpp20::process<> task_process(
     simcpp20::simulation<>& sim,
-    const models::Task& task,
-    size_t task_index,
-    const std::vector<HostPtr>& hosts,
-    NetworkLinkPtr network,
-    std::vector<simcpp20::event<>>& task_completed,
-    const std::vector<models::Task>& tasks);
+    SimulationContext& ctx,
+    size_t task_index);
+
+// Execute a task on its host with the straggler slowdown applied. Past the
+// speculation threshold a backup copy is raced against it on another host;
+// the first copy to finish sets the task's finish time, the other is cancelled.
+simcpp20::process<> speculative_execution(
+    simcpp20::simulation<>& sim,
+    SimulationContext& ctx,
+    size_t task_index);
 
 // Main simulator for task execution
 class TaskSimulator {
@@ -66,13 +409,95 @@ public:
     // Run the simulation until all tasks complete
     void run(bool verbose = false);
 
+    // Simulated time at which the last run finished
+    int64_t makespan() const { return makespan_; }
+
+    // Tasks with resolved indices and their recorded timings
+    const std::vector<models::Task>& tasks() const { return tasks_; }
+    const std::vector<TaskRecord>& records() const { return records_; }
+    const std::vector<HostPtr>& hosts() const { return hosts_; }
+
+    // Live counters, safe to read from other threads during run()
+    const EngineCounters& counters() const { return counters_; }
+
+    // Human-readable snapshot of the current simulation state: time, the
+    // longest CPU and RAM waiter queues, busy links and the oldest pending tasks
+    std::string state_dump(size_t top_n = 5) const;
+
+    // Record resource levels during run() (call after init, before run)
+    void enable_timeseries();
+
+    // Approximate mode: round timed waits to multiples of `quantum`
+    // (call after init, before run)
+    void set_quantum(int64_t quantum);
+
+    // Simulate same-host chains that provably meet no contention as one
+    // macro-task each and reconstruct their members' timings afterwards.
+    // A chain qualifies when every link has a single predecessor and
+    // successor, it ends in a task nobody depends on, and its host can
+    // never make a task wait: at most one task per chain holds resources at
+    // a time, and the chains fit the host's cores and RAM together. Results
+    // are identical to the uncoarsened run (call after init, before run).
+    void enable_coarsening();
+
+    // Tasks simulated inside macro-tasks (chain members after the head)
+    size_t coarsened_tasks() const { return coarsened_tasks_; }
+
+    // Per task group throughput and slowdown of the last run, in group order
+    // of first appearance (tasks without TASK_GROUP form the "default" group)
+    std::vector<GroupStats> group_stats() const;
+
+    // Straggler and speculation statistics, nullptr unless configured
+    const StragglerState* stragglers() const { return stragglers_.get(); }
+
+    // Elastic pool of the last run, nullptr unless configured
+    const Autoscaler* autoscaler() const { return autoscaler_.get(); }
+
+    // Time a host was part of the cluster during the last run: the makespan,
+    // or the provisioned time of an autoscaled pool host
+    int64_t host_time(size_t host_index) const;
+
+    // Stream one row per finished task to `path` on a writer thread during
+    // run() (call after init, before run)
+    void enable_task_rows(const std::string& path, TaskRowFormat format);
+
+    // Log every link and core grant of run() in grant order (call after
+    // init, before run)
+    void enable_grant_log() { grants_enabled_ = true; }
+    const std::vector<GrantStep>& grants() const { return grants_; }
+
+    // Write the recorded resource levels sampled every `interval` time units
+    void write_timeseries(const std::string& path, int64_t interval) const;
+
 private:
+    // Static hosts followed by every pool host slot, in host index order
+    std::vector<std::string> all_host_names() const;
+
     simcpp20::simulation<> sim_;
     std::vector<models::Task> tasks_;
     std::vector<HostPtr> hosts_;
     NetworkLinkPtr network_;
     std::vector<simcpp20::event<>> task_completed_;
+    std::vector<TaskRecord> records_;
+    EngineCounters counters_;
+    std::unique_ptr<ResourceRecorder> recorder_;
+    std::unique_ptr<QuantumClock> quantum_;
+    std::vector<std::string> task_names_;  // Read by the task row writer
+    std::vector<std::string> host_names_;
+    std::unique_ptr<TaskRowSink> task_rows_;
+    std::unique_ptr<StragglerState> stragglers_;
+    std::vector<std::string> group_names_;
+    std::vector<DrfAdmission> admission_;  // Empty for FIFO admission
+    std::unordered_map<size_t, simcpp20::event<>> task_started_;  // Pipelined producers only
+    bool coarsening_ = false;
+    std::vector<std::vector<size_t>> chains_;  // Coarsened chains, head first
+    size_t coarsened_tasks_ = 0;
+    bool grants_enabled_ = false;
+    std::vector<GrantStep> grants_;
+    models::AutoscalingConfig autoscaling_;
+    std::unique_ptr<Autoscaler> autoscaler_;
     bool inited_ = false;
+    int64_t makespan_ = 0;
 };
 
 } // namespace simulator
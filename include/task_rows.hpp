@@ -0,0 +1,115 @@
+// Per-task result rows streamed to disk by a background writer thread
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace simulator {
+
+// Fixed-size result row of one finished task (times in simulated units)
+struct TaskRow {
+    uint32_t task;
+    uint32_t host;
+    int64_t ready;
+    int64_t start;
+    int64_t finish;
+    int64_t dependency_wait;  // Waiting for dependencies to finish
+    int64_t link_wait;        // Queued for a network link
+    int64_t transfer;         // Receiving dependency outputs
+    int64_t ram_wait;
+    int64_t cpu_wait;
+};
+
+enum class TaskRowFormat {
+    Csv,
+    Columnar
+};
+
+// Rows are recorded into one of two buffers while a writer thread drains
+// the other with large sequential writes. The simulation only blocks when
+// it fills a buffer before the writer is done with the previous one.
+class TaskRowSink {
+public:
+    // Task and host names are read by the writer thread and must outlive close()
+    TaskRowSink(const std::string& path, TaskRowFormat format,
+                const std::vector<std::string>& task_names,
+                const std::vector<std::string>& host_names,
+                size_t rows_per_buffer = 1 << 16);
+    ~TaskRowSink();
+
+    TaskRowSink(const TaskRowSink&) = delete;
+    TaskRowSink& operator=(const TaskRowSink&) = delete;
+
+    void push(const TaskRow& row) {
+        auto& buffer = buffers_[active_];
+        buffer.push_back(row);
+        if (buffer.size() == rows_per_buffer_) {
+            hand_off();
+        }
+    }
+
+    // Write the remaining rows and finish the file; rethrows a write error
+    void close();
+
+    const std::string& path() const { return path_; }
+    uint64_t rows() const { return rows_; }
+
+    // Times push() had to wait for the writer
+    uint64_t stalls() const { return stalls_; }
+
+private:
+    void hand_off();
+    void write_loop();
+    void write_header();
+    void write_block(const std::vector<TaskRow>& rows);
+    void write_bytes(const void* data, size_t size);
+
+    std::string path_;
+    TaskRowFormat format_;
+    const std::vector<std::string>& task_names_;
+    const std::vector<std::string>& host_names_;
+    size_t rows_per_buffer_;
+    std::ofstream file_;
+    std::string text_;  // CSV formatting buffer
+
+    std::vector<TaskRow> buffers_[2];
+    int active_ = 0;            // Buffer push() appends to
+    uint64_t rows_ = 0;
+    uint64_t stalls_ = 0;
+    bool closed_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable handed_over_;
+    std::condition_variable written_;
+    bool pending_ = false;      // The other buffer is waiting to be written
+    bool finishing_ = false;
+    std::exception_ptr error_;
+    std::thread writer_;        // Started once the fields above are set up
+};
+
+// Contents of a columnar task row file, one contiguous vector per column
+struct TaskRowData {
+    std::vector<std::string> task_names;
+    std::vector<std::string> host_names;
+    std::vector<uint32_t> task;
+    std::vector<uint32_t> host;
+    std::vector<int64_t> ready;
+    std::vector<int64_t> start;
+    std::vector<int64_t> finish;
+    std::vector<int64_t> dependency_wait;
+    std::vector<int64_t> link_wait;
+    std::vector<int64_t> transfer;
+    std::vector<int64_t> ram_wait;
+    std::vector<int64_t> cpu_wait;
+};
+
+TaskRowData read_task_rows(const std::string& path);
+
+} // namespace simulator
@@ -0,0 +1,87 @@
+// Resource level time series: recorded on change, downsampled on write
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace simulator {
+
+enum class SeriesKind : uint8_t {
+    RamLevel = 0,
+    RamWaiting = 1,
+    CpuBusy = 2,
+    CpuWaiting = 3,
+    LinkBusy = 4,
+    LinkWaiting = 5
+};
+
+const char* to_string(SeriesKind kind);
+
+// Records resource levels as an append-only change log. A change is only
+// logged when the value actually differs, so idle resources cost nothing;
+// link series are allocated on first use instead of for all host pairs.
+class ResourceRecorder {
+public:
+    // Host series are preallocated (4 per host); ram_capacity gives the
+    // initial RAM level of each host
+    ResourceRecorder(const std::vector<std::string>& host_names,
+                     const std::vector<int64_t>& ram_capacity);
+
+    static uint32_t host_series(size_t host_index, SeriesKind kind) {
+        return static_cast<uint32_t>(host_index * 4 + static_cast<uint8_t>(kind));
+    }
+
+    // First of the two series (busy, then waiting) of a directional link
+    uint32_t link_series(size_t from_host_index, size_t to_host_index);
+
+    void set(uint32_t series, int64_t time, int64_t value) {
+        if (current_[series] != value) {
+            current_[series] = value;
+            changes_.push_back(Change{time, series, value});
+        }
+    }
+
+    void add(uint32_t series, int64_t time, int64_t delta) {
+        set(series, time, current_[series] + delta);
+    }
+
+    size_t num_changes() const { return changes_.size(); }
+
+    // Downsample to one value per `interval` of simulated time (the value in
+    // effect at each multiple of the interval), keep only samples that differ
+    // from the previous one and write the columnar file
+    void write(const std::string& path, int64_t interval) const;
+
+private:
+    struct Change {
+        int64_t time;
+        uint32_t series;
+        int64_t value;
+    };
+
+    std::vector<std::string> host_names_;
+    std::vector<SeriesKind> kinds_;
+    std::vector<std::string> names_;
+    std::vector<int64_t> initial_;
+    std::vector<int64_t> current_;
+    std::unordered_map<uint64_t, uint32_t> link_index_;
+    std::vector<Change> changes_;
+};
+
+// Contents of a time series file. Samples are grouped by series and
+// ordered by time within a series; each column is contiguous.
+struct TimeSeriesData {
+    int64_t interval = 0;
+    std::vector<SeriesKind> kinds;
+    std::vector<std::string> names;
+    std::vector<uint32_t> sample_series;
+    std::vector<int64_t> sample_time;
+    std::vector<int64_t> sample_value;
+};
+
+TimeSeriesData read_timeseries(const std::string& path);
+
+} // namespace simulator
@@ -0,0 +1,33 @@
+// Synthetic workload generators (benchmarks, PGO training)
+
+#ifndef WORKLOADS_H_
+#define WORKLOADS_H_
+
+#include "models.h"
+#include <string>
+#include <vector>
+
+namespace workloads {
+
+enum class Kind {
+    Chain,         // One dependency chain per host, no network traffic
+    PingPong,      // Each task depends on one two steps back, alternating hosts
+    FanOut,        // 8-ary dependency tree spread over all hosts
+    RamContended   // Independent tasks each needing about half of host RAM
+};
+
+// Parse "chain", "ping_pong", "fan_out" or "ram_contended"
+Kind parse_kind(const std::string& name);
+
+std::string kind_name(Kind kind);
+
+// Hosts HOST_0..HOST_{num_hosts-1}
+models::ExperimentConfig generate_config(size_t num_hosts, int cpu_cores = 4, int ram = 10000);
+
+// Deterministic task list of the given shape
+std::vector<models::Task> generate_tasks(Kind kind, size_t num_tasks, size_t num_hosts,
+                                         int host_ram = 10000);
+
+} // namespace workloads
+
+#endif // WORKLOADS_H_
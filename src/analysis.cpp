@@ -0,0 +1,317 @@
+#include "../include/analysis.hpp"
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace simulator {
+
+namespace {
+
+constexpr size_t kMinBlockRows = 1 << 16;
+constexpr size_t kLanes = 8;
+constexpr const char* kWaitNames[] = {"dependency", "link", "transfer", "ram", "cpu"};
+
+// Largest value of a column block. The kernels below keep kLanes
+// independent accumulators in branch-free loops over contiguous columns,
+// which the compiler turns into vector instructions
+int64_t column_max(const int64_t* values, size_t n) {
+    int64_t lanes[kLanes];
+    std::fill(std::begin(lanes), std::end(lanes), std::numeric_limits<int64_t>::min());
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            lanes[l] = std::max(lanes[l], values[i + l]);
+        }
+    }
+    int64_t result = *std::max_element(std::begin(lanes), std::end(lanes));
+    for (; i < n; ++i) {
+        result = std::max(result, values[i]);
+    }
+    return result;
+}
+
+// Total, maximum and log2 histogram of a wait column block. Four
+// interleaved sub-histograms keep runs of equal buckets from serializing
+// on one counter
+void scan_waits(const int64_t* values, size_t n, WaitHistogram& out) {
+    int64_t sums[kLanes] = {};
+    int64_t maxima[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            sums[l] += values[i + l];
+            maxima[l] = std::max(maxima[l], values[i + l]);
+        }
+    }
+    for (size_t l = 0; l < kLanes; ++l) {
+        out.total += sums[l];
+        out.max = std::max(out.max, maxima[l]);
+    }
+    for (size_t j = i; j < n; ++j) {
+        out.total += values[j];
+        out.max = std::max(out.max, values[j]);
+    }
+
+    uint64_t counts[4][65] = {};
+    auto bucket = [](int64_t value) {
+        return std::bit_width(static_cast<uint64_t>(std::max<int64_t>(value, 0)));
+    };
+    i = 0;
+    for (; i + 4 <= n; i += 4) {
+        ++counts[0][bucket(values[i])];
+        ++counts[1][bucket(values[i + 1])];
+        ++counts[2][bucket(values[i + 2])];
+        ++counts[3][bucket(values[i + 3])];
+    }
+    for (; i < n; ++i) {
+        ++counts[0][bucket(values[i])];
+    }
+    for (size_t b = 0; b < out.buckets.size(); ++b) {
+        out.buckets[b] += counts[0][b] + counts[1][b] + counts[2][b] + counts[3][b];
+    }
+}
+
+// Partial results of one block of rows
+struct BlockStats {
+    std::vector<WaitHistogram> waits;
+    std::vector<uint64_t> tasks;   // Per host
+    std::vector<int64_t> busy;     // Per host
+    // Core time per host and window: partial windows at either end of a
+    // task directly, the full windows in between as a difference array
+    std::vector<int64_t> edges;
+    std::vector<int64_t> full;
+};
+
+Percentiles percentiles(int64_t* first, int64_t* last) {
+    Percentiles result;
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0) return result;
+
+    // Nearest rank, selected in increasing order so each step only
+    // partitions what lies above the previous rank
+    auto* from = first;
+    auto select = [&](size_t per_mille) {
+        size_t rank = (n * per_mille + 999) / 1000;
+        auto* nth = first + (rank > 0 ? rank - 1 : 0);
+        std::nth_element(from, nth, last);
+        from = nth;
+        return *nth;
+    };
+    result.p50 = select(500);
+    result.p90 = select(900);
+    result.p99 = select(990);
+    result.max = *std::max_element(from, last);
+    return result;
+}
+
+} // namespace
+
+TraceAnalysis analyze_task_rows(const TaskRowData& data, size_t windows, WorkStealingPool& pool) {
+    if (windows == 0) {
+        throw std::invalid_argument("Number of utilization windows must be > 0");
+    }
+
+    TraceAnalysis analysis;
+    size_t rows = data.task.size();
+    size_t num_hosts = data.host_names.size();
+    analysis.rows = rows;
+    for (const char* name : kWaitNames) {
+        analysis.waits.emplace_back().name = name;
+    }
+    for (const auto& name : data.host_names) {
+        analysis.hosts.emplace_back().name = name;
+    }
+
+    // A few blocks per worker balance the load without shrinking blocks
+    // below the point where per-block setup shows
+    size_t block_rows = std::max(kMinBlockRows, rows / (pool.size() * 4) + 1);
+    size_t num_blocks = (rows + block_rows - 1) / block_rows;
+    auto block_range = [&](size_t b) {
+        size_t first = b * block_rows;
+        return std::make_pair(first, std::min(rows, first + block_rows) - first);
+    };
+
+    // Pass 1: makespan, which fixes the window width
+    auto block_maxima = pool.map<int64_t>(num_blocks, [&](size_t b) {
+        auto [first, n] = block_range(b);
+        return column_max(data.finish.data() + first, n);
+    });
+    for (int64_t finish : block_maxima) {
+        analysis.makespan = std::max(analysis.makespan, finish);
+    }
+    int64_t num_windows_wanted = static_cast<int64_t>(windows);
+    analysis.window = std::max<int64_t>(1, (analysis.makespan + num_windows_wanted - 1) / num_windows_wanted);
+    size_t num_windows = static_cast<size_t>(std::max<int64_t>(
+        1, (analysis.makespan + analysis.window - 1) / analysis.window));
+
+    // Pass 2: histograms, per-host counts and busy time per window
+    const std::vector<int64_t>* wait_columns[] = {
+        &data.dependency_wait, &data.link_wait, &data.transfer, &data.ram_wait, &data.cpu_wait};
+    auto blocks = pool.map<BlockStats>(num_blocks, [&](size_t b) {
+        auto [first, n] = block_range(b);
+        BlockStats stats;
+        stats.waits.resize(std::size(wait_columns));
+        for (size_t c = 0; c < std::size(wait_columns); ++c) {
+            scan_waits(wait_columns[c]->data() + first, n, stats.waits[c]);
+        }
+
+        stats.tasks.assign(num_hosts, 0);
+        stats.busy.assign(num_hosts, 0);
+        stats.edges.assign(num_hosts * num_windows, 0);
+        stats.full.assign(num_hosts * (num_windows + 1), 0);
+        int64_t width = analysis.window;
+        for (size_t i = first; i < first + n; ++i) {
+            size_t host = data.host[i];
+            int64_t start = std::max<int64_t>(data.start[i], 0);
+            int64_t finish = data.finish[i];
+            ++stats.tasks[host];
+            if (finish <= start) continue;
+            stats.busy[host] += finish - start;
+
+            auto ws = static_cast<size_t>(start / width);
+            auto wf = static_cast<size_t>((finish - 1) / width);
+            int64_t* edges = stats.edges.data() + host * num_windows;
+            if (ws == wf) {
+                edges[ws] += finish - start;
+                continue;
+            }
+            edges[ws] += static_cast<int64_t>(ws + 1) * width - start;
+            edges[wf] += finish - static_cast<int64_t>(wf) * width;
+            int64_t* full = stats.full.data() + host * (num_windows + 1);
+            full[ws + 1] += width;
+            full[wf] -= width;
+        }
+        return stats;
+    });
+
+    std::vector<std::vector<uint64_t>> offsets(num_blocks, std::vector<uint64_t>(num_hosts));
+    std::vector<uint64_t> host_first(num_hosts + 1, 0);
+    for (auto& host : analysis.hosts) {
+        host.window_busy.assign(num_windows, 0);
+    }
+    std::vector<int64_t> full(num_hosts * (num_windows + 1), 0);
+    for (size_t b = 0; b < num_blocks; ++b) {
+        const auto& stats = blocks[b];
+        for (size_t c = 0; c < analysis.waits.size(); ++c) {
+            auto& wait = analysis.waits[c];
+            wait.total += stats.waits[c].total;
+            wait.max = std::max(wait.max, stats.waits[c].max);
+            for (size_t k = 0; k < wait.buckets.size(); ++k) {
+                wait.buckets[k] += stats.waits[c].buckets[k];
+            }
+        }
+        for (size_t h = 0; h < num_hosts; ++h) {
+            auto& host = analysis.hosts[h];
+            offsets[b][h] = host.tasks;  // Relative to the host's range for now
+            host.tasks += stats.tasks[h];
+            host.busy += stats.busy[h];
+            for (size_t w = 0; w < num_windows; ++w) {
+                host.window_busy[w] += stats.edges[h * num_windows + w];
+            }
+        }
+        for (size_t k = 0; k < full.size(); ++k) {
+            full[k] += stats.full[k];
+        }
+    }
+    for (size_t h = 0; h < num_hosts; ++h) {
+        host_first[h + 1] = host_first[h] + analysis.hosts[h].tasks;
+        int64_t running = 0;
+        for (size_t w = 0; w < num_windows; ++w) {
+            running += full[h * (num_windows + 1) + w];
+            analysis.hosts[h].window_busy[w] += running;
+        }
+    }
+    blocks.clear();
+
+    // Pass 3: group durations by host (a parallel counting sort with the
+    // offsets from pass 2), then select percentiles per host
+    std::vector<int64_t> queue(rows);
+    std::vector<int64_t> response(rows);
+    pool.map<size_t>(num_blocks, [&](size_t b) {
+        auto [first, n] = block_range(b);
+        auto next = offsets[b];
+        for (size_t h = 0; h < num_hosts; ++h) {
+            next[h] += host_first[h];
+        }
+        for (size_t i = first; i < first + n; ++i) {
+            auto slot = next[data.host[i]]++;
+            queue[slot] = data.start[i] - data.ready[i];
+            response[slot] = data.finish[i] - data.ready[i];
+        }
+        return n;
+    });
+    auto host_percentiles = pool.map<std::pair<Percentiles, Percentiles>>(num_hosts, [&](size_t h) {
+        return std::make_pair(
+            percentiles(queue.data() + host_first[h], queue.data() + host_first[h + 1]),
+            percentiles(response.data() + host_first[h], response.data() + host_first[h + 1]));
+    });
+    for (size_t h = 0; h < num_hosts; ++h) {
+        analysis.hosts[h].queue = host_percentiles[h].first;
+        analysis.hosts[h].response = host_percentiles[h].second;
+    }
+    return analysis;
+}
+
+std::string format_analysis(const TraceAnalysis& analysis) {
+    std::ostringstream out;
+    out << "Rows:                   " << analysis.rows << "\n";
+    out << "Makespan:               " << analysis.makespan << "\n";
+
+    out << "Wait times (count per log2 bucket):\n";
+    for (const auto& wait : analysis.waits) {
+        out << "  " << std::left << std::setw(11) << (wait.name + ":") << std::right
+            << "total " << wait.total << ", max " << wait.max << "\n   ";
+        for (size_t b = 0; b < wait.buckets.size(); ++b) {
+            if (wait.buckets[b] == 0) continue;
+            out << " ";
+            if (b <= 1) {
+                out << b;
+            } else {
+                out << (uint64_t{1} << (b - 1)) << "-" << (b < 64 ? (uint64_t{1} << b) - 1
+                                                                  : std::numeric_limits<uint64_t>::max());
+            }
+            out << ":" << wait.buckets[b];
+        }
+        out << "\n";
+    }
+
+    out << "Hosts (queue = start - ready, response = finish - ready; p50/p90/p99/max):\n";
+    out << "  " << std::left << std::setw(16) << "HOST" << std::right << std::setw(12) << "TASKS"
+        << std::setw(14) << "BUSY" << std::setw(28) << "QUEUE" << std::setw(28) << "RESPONSE" << "\n";
+    auto format = [](const Percentiles& p) {
+        return std::to_string(p.p50) + "/" + std::to_string(p.p90) + "/" +
+               std::to_string(p.p99) + "/" + std::to_string(p.max);
+    };
+    for (const auto& host : analysis.hosts) {
+        out << "  " << std::left << std::setw(16) << host.name << std::right << std::setw(12) << host.tasks
+            << std::setw(14) << host.busy << std::setw(28) << format(host.queue)
+            << std::setw(28) << format(host.response) << "\n";
+    }
+
+    out << "Busy cores per window of " << analysis.window << ":\n";
+    out << "  " << std::setw(12) << "START";
+    for (const auto& host : analysis.hosts) {
+        out << std::setw(std::max<int>(10, static_cast<int>(host.name.size()) + 2)) << host.name;
+    }
+    out << "\n";
+    size_t num_windows = analysis.hosts.empty() ? 0 : analysis.hosts.front().window_busy.size();
+    for (size_t w = 0; w < num_windows; ++w) {
+        out << "  " << std::setw(12) << static_cast<int64_t>(w) * analysis.window << std::fixed
+            << std::setprecision(2);
+        for (const auto& host : analysis.hosts) {
+            out << std::setw(std::max<int>(10, static_cast<int>(host.name.size()) + 2))
+                << static_cast<double>(host.window_busy[w]) / analysis.window;
+        }
+        out << "\n";
+    }
+
+    std::string text = out.str();
+    text.pop_back();
+    return text;
+}
+
+} // namespace simulator
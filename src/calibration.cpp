@@ -0,0 +1,489 @@
+#include "../include/calibration.hpp"
+#include "../include/simulator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace simulator {
+
+namespace {
+
+std::vector<std::string> split_fields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+// Link scales are fitted as log(scale), kept within a factor of 1000
+constexpr double kMaxLogScale = 6.907755;
+
+struct Evaluation {
+    std::vector<double> residuals;  // Dependency gap residuals of the matched tasks
+    double sse = 0.0;
+};
+
+// Dense solve of a small symmetric system by Gaussian elimination with
+// partial pivoting
+std::vector<double> solve(std::vector<std::vector<double>> a, std::vector<double> b) {
+    size_t n = b.size();
+    for (size_t col = 0; col < n; ++col) {
+        size_t pivot = col;
+        for (size_t row = col + 1; row < n; ++row) {
+            if (std::abs(a[row][col]) > std::abs(a[pivot][col])) pivot = row;
+        }
+        std::swap(a[col], a[pivot]);
+        std::swap(b[col], b[pivot]);
+        if (a[col][col] == 0.0) continue;
+        for (size_t row = col + 1; row < n; ++row) {
+            double factor = a[row][col] / a[col][col];
+            for (size_t k = col; k < n; ++k) a[row][k] -= factor * a[col][k];
+            b[row] -= factor * b[col];
+        }
+    }
+    std::vector<double> x(n, 0.0);
+    for (size_t row = n; row-- > 0;) {
+        if (a[row][row] == 0.0) continue;
+        double sum = b[row];
+        for (size_t k = row + 1; k < n; ++k) sum -= a[row][k] * x[k];
+        x[row] = sum / a[row][row];
+    }
+    return x;
+}
+
+class Fitter {
+public:
+    Fitter(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+           const std::vector<ObservedTask>& observed)
+        : config_(config), tasks_(tasks) {
+        std::unordered_map<std::string, size_t> index_of;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            index_of[tasks[i].name] = i;
+        }
+        for (size_t i = 0; i < observed.size(); ++i) {
+            auto it = index_of.find(observed[i].name);
+            if (it == index_of.end()) {
+                ++unmatched_;
+                continue;
+            }
+            matched_.emplace_back(it->second, i);
+        }
+        if (matched_.empty()) {
+            throw std::invalid_argument("No observed task matches a task of the workload");
+        }
+        std::sort(matched_.begin(), matched_.end());
+        observed_.reserve(matched_.size());
+        for (auto [task_index, observed_index] : matched_) {
+            observed_.push_back(observed[observed_index]);
+        }
+        int64_t origin = observed_.front().start;
+        for (const auto& task : observed_) {
+            origin = std::min(origin, task.start);
+        }
+        for (const auto& task : observed_) {
+            observed_times_.emplace_back(task.start - origin, task.finish - origin);
+        }
+
+        // Gaps between a task's start and its last dependency's finish, when
+        // all its dependencies were observed too
+        std::vector<size_t> position(tasks.size(), SIZE_MAX);
+        for (size_t m = 0; m < matched_.size(); ++m) {
+            position[matched_[m].first] = m;
+        }
+        dependencies_.resize(matched_.size());
+        observed_gaps_.resize(matched_.size());
+        for (size_t m = 0; m < matched_.size(); ++m) {
+            for (const auto& dep_name : tasks[matched_[m].first].dependencies) {
+                dependencies_[m].push_back(position[index_of.at(dep_name)]);
+            }
+            if (std::find(dependencies_[m].begin(), dependencies_[m].end(), SIZE_MAX) != dependencies_[m].end()) {
+                dependencies_[m].clear();
+            }
+            observed_gaps_[m] = gap(m, observed_times_);
+        }
+
+        // Links carrying at least one transfer, each starting at its
+        // configured scale
+        std::map<std::pair<std::string, std::string>, std::pair<size_t, int64_t>> transfers;  // Count, total time
+        for (const auto& task : tasks) {
+            for (const auto& dep_name : task.dependencies) {
+                const auto& dep = tasks[index_of.at(dep_name)];
+                if (dep.host != task.host && dep.network_time > 0) {
+                    auto& [count, total] = transfers[{dep.host, task.host}];
+                    ++count;
+                    total += dep.network_time;
+                }
+            }
+        }
+        for (const auto& [link, transfer] : transfers) {
+            LinkFit fit{link.first, link.second, transfer.first};
+            for (const auto& scale : config.link_scales) {
+                if (scale.from == link.first && scale.to == link.second) fit.scale_before = scale.scale;
+            }
+            links_.push_back(fit);
+            mean_network_time_.push_back(static_cast<double>(transfer.second) / static_cast<double>(transfer.first));
+        }
+    }
+
+    size_t matched() const { return matched_.size(); }
+    size_t unmatched() const { return unmatched_; }
+    const std::vector<LinkFit>& links() const { return links_; }
+
+    // Finite difference step for link j at log(scale) x: at least `step`,
+    // and enough to move its mean transfer by a time unit, since transfer
+    // times are rounded
+    double difference_step(size_t j, double x, double step) const {
+        double transfer = mean_network_time_[j] * std::exp(x);
+        return std::min(1.0, std::max(step, std::log1p(1.0 / transfer)));
+    }
+
+    // Closed-form speeds: a task's observed execution time d is modelled as
+    // k * b, with b its run_time at the configured speed. The least-squares
+    // k = sum(b * d) / sum(b * b) divides the host's speeds.
+    std::vector<HostFit> fit_speeds() {
+        std::map<std::string, std::pair<double, double>> sums;  // sum(b * d), sum(b * b)
+        std::map<std::string, size_t> counts;
+        for (size_t m = 0; m < matched_.size(); ++m) {
+            const auto& task = tasks_[matched_[m].first];
+            auto host = config_.hosts.find(task.host);
+            if (host == config_.hosts.end()) {
+                throw std::invalid_argument("Task '" + task.name + "' references unknown host: '" + task.host + "'");
+            }
+            double speed = host->second.speed;
+            auto it = host->second.class_speeds.find(task.scaling_class);
+            if (!task.scaling_class.empty() && it != host->second.class_speeds.end()) {
+                speed = it->second;
+            }
+            double b = task.run_time / speed;
+            double d = static_cast<double>(observed_[m].finish - observed_[m].start);
+            sums[task.host].first += b * d;
+            sums[task.host].second += b * b;
+            ++counts[task.host];
+        }
+
+        std::vector<HostFit> fits;
+        for (auto& [name, host] : config_.hosts) {
+            HostFit fit{name, counts[name], host.speed, host.speed};
+            auto [bd, bb] = sums[name];
+            if (bd > 0.0 && bb > 0.0) {
+                double k = bd / bb;
+                host.speed /= k;
+                for (auto& [class_name, class_speed] : host.class_speeds) {
+                    class_speed /= k;
+                }
+                fit.speed_after = host.speed;
+            }
+            fits.push_back(fit);
+        }
+        std::sort(fits.begin(), fits.end(), [](const HostFit& a, const HostFit& b) { return a.name < b.name; });
+        return fits;
+    }
+
+    models::ExperimentConfig config_with(const std::vector<double>& log_scales) const {
+        auto config = config_;
+        for (size_t j = 0; j < links_.size(); ++j) {
+            const auto& link = links_[j];
+            std::erase_if(config.link_scales, [&](const models::LinkScale& scale) {
+                return scale.from == link.from && scale.to == link.to;
+            });
+            config.link_scales.push_back(models::LinkScale{link.from, link.to, std::exp(log_scales[j])});
+        }
+        return config;
+    }
+
+    // Simulated start and finish of the matched tasks, from their earliest start
+    std::vector<std::pair<int64_t, int64_t>> simulate(const models::ExperimentConfig& config) const {
+        TaskSimulator sim(config, std::vector<models::Task>(tasks_));
+        sim.run();
+        std::vector<std::pair<int64_t, int64_t>> times;
+        times.reserve(matched_.size());
+        int64_t origin = sim.records()[matched_.front().first].start;
+        for (auto [task_index, observed_index] : matched_) {
+            const auto& record = sim.records()[task_index];
+            times.emplace_back(record.start, record.finish);
+            origin = std::min(origin, record.start);
+        }
+        for (auto& [start, finish] : times) {
+            start -= origin;
+            finish -= origin;
+        }
+        return times;
+    }
+
+    // Start minus the latest dependency finish of matched task m
+    int64_t gap(size_t m, const std::vector<std::pair<int64_t, int64_t>>& times) const {
+        int64_t latest = INT64_MIN;
+        for (size_t dep : dependencies_[m]) {
+            latest = std::max(latest, times[dep].second);
+        }
+        return dependencies_[m].empty() ? 0 : times[m].first - latest;
+    }
+
+    Evaluation evaluate(const std::vector<double>& log_scales) const {
+        auto times = simulate(config_with(log_scales));
+        Evaluation evaluation;
+        evaluation.residuals.reserve(2 * times.size());
+        for (size_t m = 0; m < times.size(); ++m) {
+            if (!dependencies_[m].empty()) {
+                evaluation.residuals.push_back(static_cast<double>(gap(m, times) - observed_gaps_[m]));
+            }
+        }
+        for (double r : evaluation.residuals) evaluation.sse += r * r;
+        return evaluation;
+    }
+
+    ResidualStats stats(const models::ExperimentConfig& config, std::vector<TaskResidual>* rows) const {
+        auto times = simulate(config);
+        ResidualStats stats;
+        double start_sse = 0.0;
+        double finish_sse = 0.0;
+        double finish_sum = 0.0;
+        for (size_t m = 0; m < times.size(); ++m) {
+            auto [observed_start, observed_finish] = observed_times_[m];
+            double start_residual = static_cast<double>(times[m].first - observed_start);
+            int64_t finish_residual = times[m].second - observed_finish;
+            start_sse += start_residual * start_residual;
+            finish_sse += static_cast<double>(finish_residual) * static_cast<double>(finish_residual);
+            finish_sum += static_cast<double>(finish_residual);
+            stats.finish_max = std::max(stats.finish_max, std::abs(finish_residual));
+            stats.makespan_simulated = std::max(stats.makespan_simulated, times[m].second);
+            stats.makespan_observed = std::max(stats.makespan_observed, observed_finish);
+            if (rows) {
+                rows->push_back(TaskResidual{observed_[m].name, observed_start, times[m].first,
+                                             observed_finish, times[m].second});
+            }
+        }
+        double n = static_cast<double>(times.size());
+        stats.start_rmse = std::sqrt(start_sse / n);
+        stats.finish_rmse = std::sqrt(finish_sse / n);
+        stats.finish_bias = finish_sum / n;
+        return stats;
+    }
+
+private:
+    models::ExperimentConfig config_;
+    const std::vector<models::Task>& tasks_;
+    std::vector<std::pair<size_t, size_t>> matched_;  // (task index, observed index), in task order
+    std::vector<ObservedTask> observed_;              // Matched observations, in task order
+    std::vector<std::pair<int64_t, int64_t>> observed_times_;  // Their start and finish from the earliest start
+    std::vector<std::vector<size_t>> dependencies_;   // Matched positions, empty if one is unobserved
+    std::vector<int64_t> observed_gaps_;
+    size_t unmatched_ = 0;
+    std::vector<LinkFit> links_;
+    std::vector<double> mean_network_time_;  // Per link, unscaled
+};
+
+} // namespace
+
+std::vector<ObservedTask> parse_observed_log(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open observed log: " + path);
+    }
+
+    std::string line;
+    size_t line_number = 0;
+    size_t name_column = SIZE_MAX, start_column = SIZE_MAX, finish_column = SIZE_MAX;
+    while (std::getline(file, line)) {
+        ++line_number;
+        auto fields = split_fields(line);
+        if (fields.empty() || fields[0] != "TASK_NAME") continue;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i] == "TASK_NAME") name_column = i;
+            if (fields[i] == "START") start_column = i;
+            if (fields[i] == "FINISH") finish_column = i;
+        }
+        break;
+    }
+    if (name_column == SIZE_MAX || start_column == SIZE_MAX || finish_column == SIZE_MAX) {
+        throw std::runtime_error("Observed log needs a TASK_NAME, START and FINISH header: " + path);
+    }
+    size_t columns = std::max({name_column, start_column, finish_column}) + 1;
+
+    std::vector<ObservedTask> observed;
+    while (std::getline(file, line)) {
+        ++line_number;
+        if (line.empty()) continue;
+        auto fields = split_fields(line);
+        if (fields.size() < columns) {
+            throw std::runtime_error("Observed log line " + std::to_string(line_number) + " has too few columns");
+        }
+        try {
+            ObservedTask task{fields[name_column], std::stoll(fields[start_column]), std::stoll(fields[finish_column])};
+            if (task.finish < task.start) {
+                throw std::invalid_argument("finish before start");
+            }
+            observed.push_back(std::move(task));
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Invalid observed log line " + std::to_string(line_number) + ": " + e.what());
+        }
+    }
+    return observed;
+}
+
+Calibration calibrate(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+                      const std::vector<ObservedTask>& observed, const CalibrationOptions& options,
+                      WorkStealingPool& pool) {
+    if (config.autoscaling.enabled) {
+        throw std::invalid_argument("Calibration does not support autoscaling");
+    }
+    if (options.step <= 0.0) {
+        throw std::invalid_argument("Calibration step must be > 0");
+    }
+
+    Fitter fitter(config, tasks, observed);
+    Calibration calibration;
+    calibration.matched_tasks = fitter.matched();
+    calibration.unmatched_observations = fitter.unmatched();
+    calibration.before = fitter.stats(config, nullptr);
+    calibration.hosts = fitter.fit_speeds();
+    calibration.links = fitter.links();
+
+    size_t n = calibration.links.size();
+    std::vector<double> x(n);
+    for (size_t j = 0; j < n; ++j) {
+        x[j] = std::log(calibration.links[j].scale_before);
+    }
+    auto current = fitter.evaluate(x);
+    calibration.simulations = 2;
+
+    // Levenberg-Marquardt: forward-difference Jacobian columns, then a few
+    // damping factors tried at once, keeping the best improvement
+    double lambda = 1e-2;
+    for (size_t iteration = 0; n > 0 && iteration < options.max_iterations; ++iteration) {
+        std::vector<double> steps(n);
+        for (size_t j = 0; j < n; ++j) {
+            steps[j] = fitter.difference_step(j, x[j], options.step);
+        }
+        auto columns = pool.map<Evaluation>(n, [&](size_t j) {
+            auto shifted = x;
+            shifted[j] += steps[j];
+            return fitter.evaluate(shifted);
+        });
+        calibration.simulations += n;
+
+        std::vector<std::vector<double>> jtj(n, std::vector<double>(n, 0.0));
+        std::vector<double> jtr(n, 0.0);
+        for (size_t i = 0; i < current.residuals.size(); ++i) {
+            std::vector<double> row(n);
+            for (size_t j = 0; j < n; ++j) {
+                row[j] = (columns[j].residuals[i] - current.residuals[i]) / steps[j];
+            }
+            for (size_t j = 0; j < n; ++j) {
+                if (row[j] == 0.0) continue;
+                jtr[j] += row[j] * current.residuals[i];
+                for (size_t k = 0; k < n; ++k) jtj[j][k] += row[j] * row[k];
+            }
+        }
+
+        const double kFactors[] = {0.1, 1.0, 10.0, 100.0};
+        struct Trial {
+            std::vector<double> x;
+            Evaluation evaluation;
+        };
+        auto trials = pool.map<Trial>(std::size(kFactors), [&](size_t t) {
+            auto damped = jtj;
+            std::vector<double> rhs(n);
+            for (size_t j = 0; j < n; ++j) {
+                // A link no residual depends on stays where it is
+                damped[j][j] = jtj[j][j] > 0.0 ? jtj[j][j] * (1.0 + lambda * kFactors[t]) : 1.0;
+                rhs[j] = -jtr[j];
+            }
+            auto delta = solve(std::move(damped), std::move(rhs));
+            Trial trial{x, {}};
+            for (size_t j = 0; j < n; ++j) {
+                trial.x[j] = std::clamp(x[j] + delta[j], -kMaxLogScale, kMaxLogScale);
+            }
+            trial.evaluation = fitter.evaluate(trial.x);
+            return trial;
+        });
+        calibration.simulations += trials.size();
+
+        size_t best = 0;
+        for (size_t t = 1; t < trials.size(); ++t) {
+            if (trials[t].evaluation.sse < trials[best].evaluation.sse) best = t;
+        }
+        if (trials[best].evaluation.sse >= current.sse) break;
+        double improvement = (current.sse - trials[best].evaluation.sse) / current.sse;
+        x = std::move(trials[best].x);
+        current = std::move(trials[best].evaluation);
+        lambda *= kFactors[best];
+        ++calibration.iterations;
+        if (improvement < 1e-4) break;
+    }
+
+    calibration.config = fitter.config_with(x);
+    for (size_t j = 0; j < n; ++j) {
+        calibration.links[j].scale_after = std::exp(x[j]);
+    }
+    calibration.after = fitter.stats(calibration.config, &calibration.residuals);
+    ++calibration.simulations;
+    return calibration;
+}
+
+void write_residuals_csv(const std::string& path, const Calibration& calibration) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open residuals file for writing: " + path);
+    }
+    file << "TASK_NAME,OBSERVED_START,SIMULATED_START,OBSERVED_FINISH,SIMULATED_FINISH,FINISH_RESIDUAL\n";
+    for (const auto& row : calibration.residuals) {
+        file << row.name << "," << row.observed_start << "," << row.simulated_start << ","
+             << row.observed_finish << "," << row.simulated_finish << ","
+             << row.simulated_finish - row.observed_finish << "\n";
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write residuals file: " + path);
+    }
+}
+
+std::string format_calibration(const Calibration& calibration) {
+    std::ostringstream out;
+    out << "Matched tasks:          " << calibration.matched_tasks;
+    if (calibration.unmatched_observations > 0) {
+        out << " (" << calibration.unmatched_observations << " log rows without a task)";
+    }
+    out << "\n";
+    out << "Simulations:            " << calibration.simulations << " (" << calibration.iterations
+        << " Levenberg-Marquardt iterations)\n";
+
+    out << std::fixed << std::setprecision(4);
+    out << "Host speeds:\n";
+    for (const auto& host : calibration.hosts) {
+        out << "  " << std::left << std::setw(16) << host.name << std::right << std::setw(10) << host.speed_before
+            << " -> " << std::setw(10) << host.speed_after << "  (" << host.tasks << " tasks)\n";
+    }
+    if (!calibration.links.empty()) {
+        out << "Link scales:\n";
+        for (const auto& link : calibration.links) {
+            out << "  " << std::left << std::setw(28) << (link.from + " -> " + link.to) << std::right
+                << std::setw(10) << link.scale_before << " -> " << std::setw(10) << link.scale_after
+                << "  (" << link.transfers << " transfers)\n";
+        }
+    }
+
+    out << std::setprecision(1);
+    out << "Residuals (simulated - observed):\n";
+    out << "  " << std::left << std::setw(8) << "" << std::right << std::setw(14) << "START RMSE"
+        << std::setw(14) << "FINISH RMSE" << std::setw(14) << "FINISH BIAS" << std::setw(14) << "FINISH MAX"
+        << std::setw(14) << "MAKESPAN" << "\n";
+    auto row = [&](const char* label, const ResidualStats& stats) {
+        out << "  " << std::left << std::setw(8) << label << std::right << std::setw(14) << stats.start_rmse
+            << std::setw(14) << stats.finish_rmse << std::setw(14) << stats.finish_bias
+            << std::setw(14) << stats.finish_max << std::setw(14) << stats.makespan_simulated << "\n";
+    };
+    row("before", calibration.before);
+    row("after", calibration.after);
+    out << "  Observed makespan:    " << calibration.after.makespan_observed;
+    return out.str();
+}
+
+} // namespace simulator
@@ -1,11 +1,73 @@
 #include "../include/config_parser.h"
 #include <tinyxml2.h>
 #include <stdexcept>
+#include <cstring>
 #include <iostream>
 #include <filesystem>
+#include <fstream>
+#include <map>
 
 namespace parsers {
 
+// <cpu_cores>, <ram> and optional <speed> children of a host element
+static models::HostConfig parse_host_config(const tinyxml2::XMLElement* host, const std::string& host_id) {
+    auto* cpu_cores_elem = host->FirstChildElement("cpu_cores");
+    auto* ram_elem = host->FirstChildElement("ram");
+
+    if (!cpu_cores_elem || !ram_elem) {
+        throw std::runtime_error("Missing cpu_cores or ram for " + host_id);
+    }
+
+    int cpu_cores = 0;
+    int ram = 0;
+
+    if (cpu_cores_elem->QueryIntText(&cpu_cores) != tinyxml2::XML_SUCCESS) {
+        throw std::runtime_error("Invalid cpu_cores value for " + host_id);
+    }
+
+    if (ram_elem->QueryIntText(&ram) != tinyxml2::XML_SUCCESS) {
+        throw std::runtime_error("Invalid ram value for " + host_id);
+    }
+
+    models::HostConfig host_config{cpu_cores, ram};
+
+    // Optional speed factors: <speed>1.5</speed> sets the host default,
+    // <speed class="io">1.1</speed> overrides it for one task scaling class
+    for (auto* speed_elem = host->FirstChildElement("speed");
+         speed_elem != nullptr;
+         speed_elem = speed_elem->NextSiblingElement("speed")) {
+
+        double speed = 0.0;
+        if (speed_elem->QueryDoubleText(&speed) != tinyxml2::XML_SUCCESS) {
+            throw std::runtime_error("Invalid speed value for " + host_id);
+        }
+
+        const char* speed_class = speed_elem->Attribute("class");
+        if (speed_class) {
+            host_config.class_speeds[speed_class] = speed;
+        } else {
+            host_config.speed = speed;
+        }
+    }
+
+    host_config.validate();
+    return host_config;
+}
+
+// Children of a host element in the format parse_host_config reads
+static void write_host_config(std::ostream& file, const models::HostConfig& host_config) {
+    file << "            <cpu_cores>" << host_config.cpu_cores << "</cpu_cores>\n";
+    file << "            <ram>" << host_config.ram << "</ram>\n";
+    if (host_config.speed != 1.0) {
+        file << "            <speed>" << host_config.speed << "</speed>\n";
+    }
+    std::map<std::string, double> class_speeds(host_config.class_speeds.begin(),
+                                               host_config.class_speeds.end());
+    for (const auto& [class_name, class_speed] : class_speeds) {
+        file << "            <speed class=\"" << class_name << "\">" << class_speed << "</speed>\n";
+    }
+}
+
 std::unordered_map<std::string, models::ExperimentConfig>
 load_experiments_from_xml(const std::string& xml_path) {
     // Check if file exists
@@ -70,33 +132,146 @@ load_experiments_from_xml(const std::string& xml_path) {
                                        std::string(name) + "'");
             }
 
-            auto* cpu_cores_elem = host->FirstChildElement("cpu_cores");
-            auto* ram_elem = host->FirstChildElement("ram");
+            config.hosts[host_id] = parse_host_config(host, host_id);
+        }
 
-            if (!cpu_cores_elem || !ram_elem) {
-                throw std::runtime_error("Missing cpu_cores or ram for " + std::string(host_id));
+        // Optional <autoscaling pool="POOL" min="1" max="8" interval="10" ...> with
+        // the pool host's <cpu_cores>, <ram> and <speed> as children
+        if (auto* autoscaling = experiment->FirstChildElement("autoscaling")) {
+            auto& scaling = config.autoscaling;
+            scaling.enabled = true;
+            if (const char* pool = autoscaling->Attribute("pool")) {
+                scaling.pool = pool;
             }
+            if (config.hosts.count(scaling.pool)) {
+                throw std::runtime_error("Autoscaling pool '" + scaling.pool + "' clashes with a host id in experiment '" +
+                                       std::string(name) + "'");
+            }
+            scaling.host = parse_host_config(autoscaling, scaling.pool);
+            auto count = [&](const char* attribute, size_t& value) {
+                const char* text = autoscaling->Attribute(attribute);
+                if (!text) return;
+                // strtoul-based parsing wraps a leading '-' instead of failing
+                unsigned int parsed = 0;
+                if (std::strchr(text, '-') ||
+                    autoscaling->QueryUnsignedAttribute(attribute, &parsed) != tinyxml2::XML_SUCCESS) {
+                    throw std::runtime_error("Invalid autoscaling " + std::string(attribute) + " '" + text +
+                                           "' in experiment '" + std::string(name) + "'");
+                }
+                value = parsed;
+            };
+            auto check = [&](const char* attribute, tinyxml2::XMLError result) {
+                if (result != tinyxml2::XML_SUCCESS && result != tinyxml2::XML_NO_ATTRIBUTE) {
+                    throw std::runtime_error("Invalid autoscaling " + std::string(attribute) + " '" +
+                                           autoscaling->Attribute(attribute) + "' in experiment '" +
+                                           std::string(name) + "'");
+                }
+            };
+            count("min", scaling.min_hosts);
+            count("max", scaling.max_hosts);
+            scaling.initial_hosts = scaling.min_hosts;
+            count("initial", scaling.initial_hosts);
+            check("interval", autoscaling->QueryInt64Attribute("interval", &scaling.interval));
+            check("cooldown", autoscaling->QueryInt64Attribute("cooldown", &scaling.cooldown));
+            check("provisioning_delay",
+                  autoscaling->QueryInt64Attribute("provisioning_delay", &scaling.provisioning_delay));
+            check("scale_up_queue", autoscaling->QueryDoubleAttribute("scale_up_queue", &scaling.scale_up_queue));
+            check("scale_up_utilization",
+                  autoscaling->QueryDoubleAttribute("scale_up_utilization", &scaling.scale_up_utilization));
+            check("scale_down_utilization",
+                  autoscaling->QueryDoubleAttribute("scale_down_utilization", &scaling.scale_down_utilization));
+            scaling.validate();
+        }
 
-            int cpu_cores = 0;
-            int ram = 0;
+        if (config.hosts.empty() && !config.autoscaling.enabled) {
+            throw std::runtime_error("Experiment '" + std::string(name) +
+                                   "' must have at least 1 host");
+        }
 
-            if (cpu_cores_elem->QueryIntText(&cpu_cores) != tinyxml2::XML_SUCCESS) {
-                throw std::runtime_error("Invalid cpu_cores value for " + std::string(host_id));
+        // Optional <stragglers probability="0.05" seed="7" slowdown="pareto" min="1.5" alpha="2"/>
+        if (auto* stragglers = experiment->FirstChildElement("stragglers")) {
+            auto& straggler_config = config.stragglers;
+            if (stragglers->QueryDoubleAttribute("probability", &straggler_config.probability) !=
+                tinyxml2::XML_SUCCESS) {
+                throw std::runtime_error("Invalid or missing stragglers probability in experiment '" +
+                                       std::string(name) + "'");
             }
+            if (const char* seed = stragglers->Attribute("seed")) {
+                unsigned long long parsed = 0;
+                if (std::strchr(seed, '-') ||
+                    stragglers->QueryUnsigned64Attribute("seed", &parsed) != tinyxml2::XML_SUCCESS) {
+                    throw std::runtime_error("Invalid stragglers seed '" + std::string(seed) + "' in experiment '" +
+                                           std::string(name) + "'");
+                }
+                straggler_config.seed = parsed;
+            }
+            std::string slowdown = stragglers->Attribute("slowdown") ? stragglers->Attribute("slowdown") : "fixed";
+            if (slowdown == "fixed") {
+                straggler_config.distribution = models::SlowdownDistribution::Fixed;
+            } else if (slowdown == "uniform") {
+                straggler_config.distribution = models::SlowdownDistribution::Uniform;
+            } else if (slowdown == "pareto") {
+                straggler_config.distribution = models::SlowdownDistribution::Pareto;
+            } else {
+                throw std::runtime_error("Unknown straggler slowdown '" + slowdown + "' in experiment '" +
+                                       std::string(name) + "' (expected fixed, uniform or pareto)");
+            }
+            stragglers->QueryDoubleAttribute("min", &straggler_config.min);
+            straggler_config.max = straggler_config.min;
+            stragglers->QueryDoubleAttribute("max", &straggler_config.max);
+            stragglers->QueryDoubleAttribute("alpha", &straggler_config.alpha);
+            straggler_config.validate();
+        }
 
-            if (ram_elem->QueryIntText(&ram) != tinyxml2::XML_SUCCESS) {
-                throw std::runtime_error("Invalid ram value for " + std::string(host_id));
+        // Optional <admission policy="drf"/> (default fifo)
+        if (auto* admission = experiment->FirstChildElement("admission")) {
+            std::string policy = admission->Attribute("policy") ? admission->Attribute("policy") : "";
+            if (policy == "fifo") {
+                config.admission = models::AdmissionPolicy::Fifo;
+            } else if (policy == "drf") {
+                config.admission = models::AdmissionPolicy::Drf;
+            } else {
+                throw std::runtime_error("Unknown admission policy '" + policy + "' in experiment '" +
+                                       std::string(name) + "' (expected fifo or drf)");
             }
+        }
 
-            models::HostConfig host_config{cpu_cores, ram};
-            host_config.validate();
+        // Optional <network links="clock"/> (default resource)
+        if (auto* network = experiment->FirstChildElement("network")) {
+            std::string links = network->Attribute("links") ? network->Attribute("links") : "";
+            if (links == "resource") {
+                config.link_model = models::LinkModel::Resource;
+            } else if (links == "clock") {
+                config.link_model = models::LinkModel::Clock;
+            } else {
+                throw std::runtime_error("Unknown link model '" + links + "' in experiment '" +
+                                       std::string(name) + "' (expected resource or clock)");
+            }
+        }
 
-            config.hosts[host_id] = host_config;
+        // Optional <speculation percentile="95"/>
+        if (auto* speculation = experiment->FirstChildElement("speculation")) {
+            config.speculation.enabled = true;
+            speculation->QueryDoubleAttribute("percentile", &config.speculation.percentile);
+            config.speculation.validate();
         }
 
-        if (config.hosts.empty()) {
-            throw std::runtime_error("Experiment '" + std::string(name) +
-                                   "' must have at least 1 host");
+        // Optional <link from="HOST_0" to="HOST_1" scale="1.3"/>, one per directed link
+        for (auto* link = experiment->FirstChildElement("link");
+             link != nullptr;
+             link = link->NextSiblingElement("link")) {
+            models::LinkScale link_scale;
+            link_scale.from = link->Attribute("from") ? link->Attribute("from") : "";
+            link_scale.to = link->Attribute("to") ? link->Attribute("to") : "";
+            if (link->QueryDoubleAttribute("scale", &link_scale.scale) != tinyxml2::XML_SUCCESS) {
+                throw std::runtime_error("Invalid or missing link scale in experiment '" + std::string(name) + "'");
+            }
+            if (!config.hosts.count(link_scale.from) || !config.hosts.count(link_scale.to)) {
+                throw std::runtime_error("Link '" + link_scale.from + "' -> '" + link_scale.to +
+                                       "' references an unknown host in experiment '" + std::string(name) + "'");
+            }
+            link_scale.validate();
+            config.link_scales.push_back(link_scale);
         }
 
         config.validate(false);
@@ -124,4 +299,74 @@ models::ExperimentConfig get_experiment_config(
     return it->second;
 }
 
+void write_experiments_xml(const std::string& xml_path,
+                           const std::unordered_map<std::string, models::ExperimentConfig>& configs) {
+    std::ofstream file(xml_path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open XML file for writing: " + xml_path);
+    }
+
+    // Sorted output keeps generated files diffable
+    std::map<std::string, const models::ExperimentConfig*> sorted_configs;
+    for (const auto& [name, config] : configs) {
+        sorted_configs[name] = &config;
+    }
+
+    file.precision(12);
+    file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<experiments>\n";
+    for (const auto& [name, config] : sorted_configs) {
+        file << "\n    <experiment name=\"" << name << "\">\n";
+        file << "        <tasks>" << config->tasks_csv_path << "</tasks>\n";
+
+        std::map<std::string, const models::HostConfig*> sorted_hosts;
+        for (const auto& [host_id, host_config] : config->hosts) {
+            sorted_hosts[host_id] = &host_config;
+        }
+        for (const auto& [host_id, host_config] : sorted_hosts) {
+            file << "        <host id=\"" << host_id << "\">\n";
+            write_host_config(file, *host_config);
+            file << "        </host>\n";
+        }
+        for (const auto& link : config->link_scales) {
+            file << "        <link from=\"" << link.from << "\" to=\"" << link.to << "\" scale=\"" << link.scale
+                 << "\"/>\n";
+        }
+        const auto& stragglers = config->stragglers;
+        if (stragglers.probability > 0.0) {
+            static const char* kSlowdowns[] = {"fixed", "uniform", "pareto"};
+            file << "        <stragglers probability=\"" << stragglers.probability << "\" seed=\"" << stragglers.seed
+                 << "\" slowdown=\"" << kSlowdowns[static_cast<int>(stragglers.distribution)]
+                 << "\" min=\"" << stragglers.min << "\" max=\"" << stragglers.max
+                 << "\" alpha=\"" << stragglers.alpha << "\"/>\n";
+        }
+        if (config->admission == models::AdmissionPolicy::Drf) {
+            file << "        <admission policy=\"drf\"/>\n";
+        }
+        if (config->link_model == models::LinkModel::Clock) {
+            file << "        <network links=\"clock\"/>\n";
+        }
+        if (config->speculation.enabled) {
+            file << "        <speculation percentile=\"" << config->speculation.percentile << "\"/>\n";
+        }
+        const auto& scaling = config->autoscaling;
+        if (scaling.enabled) {
+            file << "        <autoscaling pool=\"" << scaling.pool << "\" min=\"" << scaling.min_hosts
+                 << "\" max=\"" << scaling.max_hosts << "\" initial=\"" << scaling.initial_hosts
+                 << "\" interval=\"" << scaling.interval << "\" cooldown=\"" << scaling.cooldown
+                 << "\" provisioning_delay=\"" << scaling.provisioning_delay
+                 << "\" scale_up_queue=\"" << scaling.scale_up_queue
+                 << "\" scale_up_utilization=\"" << scaling.scale_up_utilization
+                 << "\" scale_down_utilization=\"" << scaling.scale_down_utilization << "\">\n";
+            write_host_config(file, scaling.host);
+            file << "        </autoscaling>\n";
+        }
+        file << "    </experiment>\n";
+    }
+    file << "\n</experiments>\n";
+
+    if (!file) {
+        throw std::runtime_error("Failed to write XML file: " + xml_path);
+    }
+}
+
 } // namespace parsers
@@ -1,4 +1,5 @@
 #include "../include/csv_parser.h"
+#include "../include/decompress.h"
 #include <fstream>
 #include <sstream>
 #include <unordered_set>
@@ -40,11 +41,30 @@ std::vector<models::Task> parse_tasks_csv(const std::string& csv_path) {
         throw std::runtime_error("Task CSV file not found: " + csv_path);
     }
 
+    // Compressed inputs are decompressed on a background thread while parsing
+    auto compression = detect_compression(csv_path);
+    if (compression != Compression::None) {
+        DecompressingStream stream(csv_path, compression);
+        std::vector<models::Task> tasks;
+        try {
+            tasks = parse_tasks_csv(stream);
+        } catch (const std::exception&) {
+            // A cut-off row is a symptom; report the decompression error instead
+            stream.check();
+            throw;
+        }
+        stream.check();
+        return tasks;
+    }
+
     std::ifstream file(csv_path);
     if (!file.is_open()) {
         throw std::runtime_error("Failed to open CSV file: " + csv_path);
     }
+    return parse_tasks_csv(file);
+}
 
+std::vector<models::Task> parse_tasks_csv(std::istream& file) {
     std::vector<models::Task> tasks;
     std::string line;
     int row_num = 1;
@@ -114,6 +134,22 @@ std::vector<models::Task> parse_tasks_csv(const std::string& csv_path) {
             int network_time = std::stoi(fields[header_index["TASK_NETWORK_TIME"]]);
             std::string dependency_str = fields[header_index["TASK_DEPENDENCY"]];
 
+            // Optional columns
+            std::string scaling_class;
+            if (auto it = header_index.find("TASK_SCALING_CLASS"); it != header_index.end()) {
+                scaling_class = fields[it->second];
+            }
+            std::string group;
+            if (auto it = header_index.find("TASK_GROUP"); it != header_index.end()) {
+                group = fields[it->second];
+            }
+            int pipeline_chunks = 0;
+            if (auto it = header_index.find("TASK_PIPELINE_CHUNKS"); it != header_index.end()) {
+                if (!fields[it->second].empty()) {
+                    pipeline_chunks = std::stoi(fields[it->second]);
+                }
+            }
+
             std::vector<std::string> dependencies;
             if (!dependency_str.empty()) {
                 dependencies.push_back(dependency_str);
@@ -129,7 +165,10 @@ std::vector<models::Task> parse_tasks_csv(const std::string& csv_path) {
                 dependencies,
                 {},
                 tasks.size(),
-                0
+                0,
+                scaling_class,
+                group,
+                pipeline_chunks
             };
 
             task.validate();
@@ -143,6 +182,53 @@ std::vector<models::Task> parse_tasks_csv(const std::string& csv_path) {
     return tasks;
 }
 
+void write_tasks_csv(const std::string& csv_path, const std::vector<models::Task>& tasks) {
+    std::ofstream file(csv_path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open CSV file for writing: " + csv_path);
+    }
+
+    bool has_scaling_class = std::any_of(tasks.begin(), tasks.end(),
+        [](const models::Task& task) { return !task.scaling_class.empty(); });
+    bool has_group = std::any_of(tasks.begin(), tasks.end(),
+        [](const models::Task& task) { return !task.group.empty(); });
+    bool has_pipeline_chunks = std::any_of(tasks.begin(), tasks.end(),
+        [](const models::Task& task) { return task.pipeline_chunks != 0; });
+
+    file << "TASK_NAME,TASK_HOST,TASK_INITIAL_SLEEP_TIME,TASK_RUN_TIME,TASK_RAM,"
+            "TASK_NETWORK_TIME,TASK_DEPENDENCY";
+    if (has_scaling_class) {
+        file << ",TASK_SCALING_CLASS";
+    }
+    if (has_group) {
+        file << ",TASK_GROUP";
+    }
+    if (has_pipeline_chunks) {
+        file << ",TASK_PIPELINE_CHUNKS";
+    }
+    file << "\n";
+
+    for (const auto& task : tasks) {
+        file << task.name << ',' << task.host << ',' << task.initial_sleep_time << ','
+             << task.run_time << ',' << task.ram << ',' << task.network_time << ','
+             << (task.dependencies.empty() ? "" : task.dependencies.front());
+        if (has_scaling_class) {
+            file << ',' << task.scaling_class;
+        }
+        if (has_group) {
+            file << ',' << task.group;
+        }
+        if (has_pipeline_chunks) {
+            file << ',' << task.pipeline_chunks;
+        }
+        file << "\n";
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed to write CSV file: " + csv_path);
+    }
+}
+
 // Helper function for cycle detection (DFS)
 static bool has_cycle(const std::string& task_name,
                       const std::unordered_map<std::string, models::Task>& task_dict,
@@ -0,0 +1,289 @@
+#include "../include/decompress.h"
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifdef TASK_SIMULATOR_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef TASK_SIMULATOR_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace parsers {
+
+namespace {
+
+constexpr size_t kChunkSize = 1 << 20;    // Decompressed bytes per queued chunk
+constexpr size_t kQueueCapacity = 4;      // Chunks decompressed ahead of the parser
+constexpr size_t kReadSize = 256 << 10;   // Compressed bytes read per call
+
+// Bounded single-producer/single-consumer queue of decompressed chunks
+class ChunkQueue {
+public:
+    // Blocks while full; false once the consumer has gone away
+    bool push(std::string chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return chunks_.size() < kQueueCapacity || closed_; });
+        if (closed_) return false;
+        chunks_.push_back(std::move(chunk));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Blocks while empty; false at the end of the stream
+    bool pop(std::string& chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !chunks_.empty() || finished_; });
+        if (chunks_.empty()) return false;
+        chunk = std::move(chunks_.front());
+        chunks_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    // Producer side: no more chunks, optionally because of an error
+    void finish(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+        error_ = error;
+        not_empty_.notify_one();
+    }
+
+    // Consumer side: stop the producer
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_full_.notify_one();
+    }
+
+    std::exception_ptr error() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::string> chunks_;
+    bool finished_ = false;
+    bool closed_ = false;
+    std::exception_ptr error_;
+};
+
+// Collects decompressed output into chunks of kChunkSize
+class ChunkWriter {
+public:
+    explicit ChunkWriter(ChunkQueue& queue) : queue_(queue) { chunk_.resize(kChunkSize); }
+
+    char* data() { return chunk_.data() + used_; }
+    size_t space() const { return kChunkSize - used_; }
+
+    // Account for `n` bytes written at data(); false if the consumer stopped
+    bool commit(size_t n) {
+        used_ += n;
+        return used_ < kChunkSize || flush();
+    }
+
+    bool flush() {
+        if (used_ == 0) return true;
+        chunk_.resize(used_);
+        bool accepted = queue_.push(std::move(chunk_));
+        chunk_ = std::string(kChunkSize, '\0');
+        used_ = 0;
+        return accepted;
+    }
+
+private:
+    ChunkQueue& queue_;
+    std::string chunk_;
+    size_t used_ = 0;
+};
+
+#ifdef TASK_SIMULATOR_HAVE_ZLIB
+void inflate_gzip(std::ifstream& in, ChunkWriter& out, const std::string& path) {
+    z_stream stream{};
+    // 15 window bits + 32: accept gzip and zlib headers
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        throw std::runtime_error("Failed to initialize gzip decompression");
+    }
+    std::unique_ptr<z_stream, int (*)(z_stream*)> guard(&stream, inflateEnd);
+
+    std::string input(kReadSize, '\0');
+    bool member_done = false;
+    for (;;) {
+        if (stream.avail_in == 0) {
+            in.read(input.data(), static_cast<std::streamsize>(input.size()));
+            stream.next_in = reinterpret_cast<Bytef*>(input.data());
+            stream.avail_in = static_cast<uInt>(in.gcount());
+            if (stream.avail_in == 0) break;
+        }
+
+        // Concatenated gzip members (e.g. from pigz or `cat a.gz b.gz`)
+        if (member_done) {
+            inflateReset(&stream);
+            member_done = false;
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(out.data());
+        stream.avail_out = static_cast<uInt>(out.space());
+        int status = inflate(&stream, Z_NO_FLUSH);
+        if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+            throw std::runtime_error("Corrupt gzip data in " + path + ": " +
+                                     (stream.msg ? stream.msg : "inflate failed"));
+        }
+        if (!out.commit(out.space() - stream.avail_out)) return;
+        member_done = status == Z_STREAM_END;
+    }
+
+    if (!member_done) {
+        throw std::runtime_error("Truncated gzip data in " + path);
+    }
+}
+#endif
+
+#ifdef TASK_SIMULATOR_HAVE_ZSTD
+void decompress_zstd(std::ifstream& in, ChunkWriter& out, const std::string& path) {
+    std::unique_ptr<ZSTD_DStream, size_t (*)(ZSTD_DStream*)> stream(ZSTD_createDStream(), ZSTD_freeDStream);
+    if (!stream || ZSTD_isError(ZSTD_initDStream(stream.get()))) {
+        throw std::runtime_error("Failed to initialize zstd decompression");
+    }
+
+    std::string input(kReadSize, '\0');
+    ZSTD_inBuffer in_buffer{input.data(), 0, 0};
+    size_t pending = 0;  // 0 once a frame is complete and flushed
+    for (;;) {
+        if (in_buffer.pos == in_buffer.size) {
+            in.read(input.data(), static_cast<std::streamsize>(input.size()));
+            in_buffer.size = static_cast<size_t>(in.gcount());
+            in_buffer.pos = 0;
+            if (in_buffer.size == 0 && pending == 0) break;
+        }
+
+        // At end of input this only flushes output the decoder still holds
+        ZSTD_outBuffer out_buffer{out.data(), out.space(), 0};
+        pending = ZSTD_decompressStream(stream.get(), &out_buffer, &in_buffer);
+        if (ZSTD_isError(pending)) {
+            throw std::runtime_error("Corrupt zstd data in " + path + ": " + ZSTD_getErrorName(pending));
+        }
+        if (!out.commit(out_buffer.pos)) return;
+        if (in_buffer.size == 0 && out_buffer.pos == 0) break;
+    }
+
+    if (pending != 0) {
+        throw std::runtime_error("Truncated zstd data in " + path);
+    }
+}
+#endif
+
+} // namespace
+
+// Stream buffer handing out the chunks produced by the decompression thread
+class DecompressingBuffer : public std::streambuf {
+public:
+    DecompressingBuffer(const std::string& path, Compression compression)
+        : producer_(&DecompressingBuffer::produce, this, path, compression) {}
+
+    ~DecompressingBuffer() override {
+        queue_.close();
+        producer_.join();
+    }
+
+    std::exception_ptr error() const { return queue_.error(); }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        if (!queue_.pop(current_)) {
+            return traits_type::eof();
+        }
+        setg(current_.data(), current_.data(), current_.data() + current_.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    void produce(std::string path, Compression compression) {
+        try {
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) {
+                throw std::runtime_error("Failed to open compressed file: " + path);
+            }
+
+            ChunkWriter out(queue_);
+            switch (compression) {
+                case Compression::Gzip:
+#ifdef TASK_SIMULATOR_HAVE_ZLIB
+                    inflate_gzip(in, out, path);
+                    break;
+#else
+                    throw std::runtime_error(path + " is gzip-compressed but zlib support is not built in");
+#endif
+                case Compression::Zstd:
+#ifdef TASK_SIMULATOR_HAVE_ZSTD
+                    decompress_zstd(in, out, path);
+                    break;
+#else
+                    throw std::runtime_error(path + " is zstd-compressed but zstd support is not built in");
+#endif
+                case Compression::None:
+                    throw std::invalid_argument("DecompressingStream requires a compressed input");
+            }
+            out.flush();
+            queue_.finish(nullptr);
+        } catch (...) {
+            queue_.finish(std::current_exception());
+        }
+    }
+
+    ChunkQueue queue_;
+    std::string current_;
+    std::thread producer_;  // Last member: its thread uses the fields above
+};
+
+const char* to_string(Compression compression) {
+    switch (compression) {
+        case Compression::None: return "none";
+        case Compression::Gzip: return "gzip";
+        case Compression::Zstd: return "zstd";
+    }
+    return "unknown";
+}
+
+Compression detect_compression(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned char magic[4] = {};
+    in.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    size_t n = static_cast<size_t>(in.gcount());
+
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        return Compression::Gzip;
+    }
+    if (n >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+DecompressingStream::DecompressingStream(const std::string& path, Compression compression)
+    : std::istream(nullptr),
+      buffer_(std::make_unique<DecompressingBuffer>(path, compression)) {
+    rdbuf(buffer_.get());
+}
+
+DecompressingStream::~DecompressingStream() = default;
+
+void DecompressingStream::check() const {
+    if (auto error = buffer_->error()) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace parsers
@@ -0,0 +1,152 @@
+#include "../include/executor.hpp"
+#include <algorithm>
+
+namespace simulator {
+
+namespace {
+
+// Pool and index of the worker running on this thread
+thread_local const WorkStealingPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+} // namespace
+
+void WorkStealingPool::Batch::finish_one() {
+    // Notify under the lock: the waiter destroys the batch once it returns
+    std::lock_guard<std::mutex> lock(mutex);
+    if (--remaining == 0) {
+        done.notify_all();
+    }
+}
+
+WorkStealingPool::WorkStealingPool(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    threads_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads_.emplace_back(&WorkStealingPool::worker_loop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> job) {
+    // Jobs submitted by a job stay with its worker, outside jobs are dealt
+    // out round robin; stealing evens out whatever imbalance remains
+    size_t target = current_pool == this
+        ? current_worker
+        : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+        workers_[target]->jobs.push_back(std::move(job));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        ++queued_;
+    }
+    wake_.notify_one();
+}
+
+bool WorkStealingPool::run_one(size_t self) {
+    std::function<void()> job;
+    bool stolen = false;
+    {
+        auto& own = *workers_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+    for (size_t offset = 1; !job && offset < workers_.size(); ++offset) {
+        auto& victim = *workers_[(self + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            stolen = true;
+        }
+    }
+    if (!job) return false;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        --queued_;
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    job();
+    auto busy = std::chrono::steady_clock::now() - started;
+
+    auto& own = *workers_[self];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    ++own.stats.jobs;
+    own.stats.steals += stolen;
+    own.stats.busy += std::chrono::duration_cast<std::chrono::nanoseconds>(busy);
+    return true;
+}
+
+void WorkStealingPool::wait(Batch& batch) {
+    if (current_pool != this) {
+        std::unique_lock<std::mutex> lock(batch.mutex);
+        batch.done.wait(lock, [&batch] { return batch.remaining == 0; });
+        return;
+    }
+
+    // A worker waiting for nested jobs keeps running queued work (its own
+    // jobs first) so the pool cannot deadlock on its own submissions
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            if (batch.remaining == 0) return;
+        }
+        if (!run_one(current_worker)) {
+            std::unique_lock<std::mutex> lock(batch.mutex);
+            batch.done.wait_for(lock, std::chrono::milliseconds(1),
+                                [&batch] { return batch.remaining == 0; });
+        }
+    }
+}
+
+void WorkStealingPool::worker_loop(size_t self) {
+    current_pool = this;
+    current_worker = self;
+    for (;;) {
+        if (run_one(self)) continue;
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this] { return queued_ > 0 || stopping_; });
+        if (stopping_ && queued_ <= 0) return;
+    }
+}
+
+std::vector<WorkStealingPool::WorkerStats> WorkStealingPool::stats() const {
+    std::vector<WorkerStats> result;
+    result.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        result.push_back(worker->stats);
+    }
+    return result;
+}
+
+void WorkStealingPool::reset_stats() {
+    for (auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->stats = WorkerStats{};
+    }
+}
+
+} // namespace simulator
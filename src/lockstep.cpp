@@ -0,0 +1,280 @@
+#include "lockstep.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace simulator {
+
+namespace {
+
+constexpr size_t W = kLockstepLanes;
+
+// One time per lane, aligned so the lane loops compile to vector code
+struct alignas(64) Lanes {
+    std::array<int64_t, W> at{};
+};
+
+Lanes splat(int64_t value) {
+    Lanes lanes;
+    lanes.at.fill(value);
+    return lanes;
+}
+
+void max_into(Lanes& into, const Lanes& other) {
+    for (size_t l = 0; l < W; ++l) {
+        into.at[l] = std::max(into.at[l], other.at[l]);
+    }
+}
+
+// Serve `request` on a FIFO resource whose requests so far came in at
+// `last` and whose earliest free unit frees at `free`. Flags lanes where
+// the logged order is not FIFO for them, or where a tie decides who waits.
+// @return Start time per lane
+Lanes serve(const Lanes& request, const Lanes& free, Lanes& last, std::array<uint8_t, W>& diverged) {
+    Lanes start;
+    for (size_t l = 0; l < W; ++l) {
+        start.at[l] = std::max(request.at[l], free.at[l]);
+        bool out_of_order = request.at[l] < last.at[l];
+        bool tie_waits = request.at[l] == last.at[l] && start.at[l] > request.at[l];
+        diverged[l] |= static_cast<uint8_t>(out_of_order | tie_waits);
+        last.at[l] = request.at[l];
+    }
+    return start;
+}
+
+struct ReplayResult {
+    std::array<uint8_t, W> diverged{};
+    std::vector<Lanes> ready;
+    std::vector<Lanes> start;
+    std::vector<Lanes> finish;
+};
+
+// Replay the logged grant order for W straggler draws at once
+ReplayResult replay(const std::vector<models::Task>& tasks, const std::vector<HostPtr>& hosts,
+                    const std::vector<GrantStep>& grants, const std::vector<Lanes>& exec_time) {
+    size_t n = tasks.size();
+    ReplayResult result;
+    result.ready.resize(n);
+    result.start.resize(n);
+    result.finish.resize(n);
+    auto& diverged = result.diverged;
+
+    // Time each task process reached, and how many of its dependencies it passed
+    std::vector<Lanes> cursor(n);
+    std::vector<size_t> passed(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        cursor[i] = splat(tasks[i].initial_sleep_time);
+    }
+    auto pass_until = [&](size_t task, size_t dep) {
+        const auto& deps = tasks[task].dependency_indices;
+        while (passed[task] < deps.size()) {
+            size_t dep_index = deps[passed[task]++];
+            max_into(cursor[task], result.finish[dep_index]);
+            if (dep_index == dep) break;
+        }
+    };
+
+    // Core free times, cores of host h at [core_offset[h], core_offset[h + 1])
+    std::vector<size_t> core_offset(hosts.size() + 1, 0);
+    for (size_t h = 0; h < hosts.size(); ++h) {
+        core_offset[h + 1] = core_offset[h] + static_cast<size_t>(std::max(hosts[h]->cpu_cores, 0));
+    }
+    std::vector<Lanes> core_free(core_offset.back());
+    std::vector<Lanes> core_last(hosts.size(), splat(-1));
+
+    std::unordered_map<uint64_t, size_t> link_index;
+    std::vector<Lanes> link_free;
+    std::vector<Lanes> link_last;
+
+    size_t cores_granted = 0;
+    for (const auto& grant : grants) {
+        size_t i = grant.task;
+        const auto& task = tasks[i];
+
+        if (grant.dep != GrantStep::kCoreGrant) {
+            pass_until(i, grant.dep);
+            uint64_t key = static_cast<uint64_t>(tasks[grant.dep].host_index) << 32 | task.host_index;
+            auto [it, inserted] = link_index.try_emplace(key, link_free.size());
+            if (inserted) {
+                link_free.push_back(splat(0));
+                link_last.push_back(splat(-1));
+            }
+            Lanes start = serve(cursor[i], link_free[it->second], link_last[it->second], diverged);
+            for (size_t l = 0; l < W; ++l) {
+                cursor[i].at[l] = start.at[l] + grant.transfer;
+            }
+            link_free[it->second] = cursor[i];
+            continue;
+        }
+
+        pass_until(i, SIZE_MAX);
+        result.ready[i] = cursor[i];
+        size_t first = core_offset[task.host_index];
+        size_t last = core_offset[task.host_index + 1];
+        if (first == last) {
+            diverged.fill(1);
+            break;
+        }
+        Lanes earliest = core_free[first];
+        for (size_t c = first + 1; c < last; ++c) {
+            for (size_t l = 0; l < W; ++l) {
+                earliest.at[l] = std::min(earliest.at[l], core_free[c].at[l]);
+            }
+        }
+        Lanes start = serve(cursor[i], earliest, core_last[task.host_index], diverged);
+        Lanes finish;
+        for (size_t l = 0; l < W; ++l) {
+            finish.at[l] = start.at[l] + exec_time[i].at[l];
+        }
+        // The first core that frees earliest takes the task
+        std::array<uint8_t, W> placed{};
+        for (size_t c = first; c < last; ++c) {
+            for (size_t l = 0; l < W; ++l) {
+                bool take = !placed[l] && core_free[c].at[l] == earliest.at[l];
+                core_free[c].at[l] = take ? finish.at[l] : core_free[c].at[l];
+                placed[l] |= static_cast<uint8_t>(take);
+            }
+        }
+        result.start[i] = start;
+        result.finish[i] = finish;
+        ++cores_granted;
+    }
+    if (cores_granted != n) {
+        diverged.fill(1);
+        return result;
+    }
+
+    // RAM never made a task wait if, counting every hold that may overlap
+    // a request (ties included), no host exceeds its RAM
+    std::vector<std::vector<size_t>> host_tasks(hosts.size());
+    for (size_t i = 0; i < n; ++i) {
+        if (tasks[i].ram > 0) host_tasks[tasks[i].host_index].push_back(i);
+    }
+    std::vector<std::pair<int64_t, int64_t>> changes;
+    for (size_t l = 0; l < W; ++l) {
+        for (size_t h = 0; h < hosts.size() && !diverged[l]; ++h) {
+            changes.clear();
+            for (size_t i : host_tasks[h]) {
+                changes.emplace_back(result.ready[i].at[l], tasks[i].ram);
+                changes.emplace_back(result.finish[i].at[l], -tasks[i].ram);
+            }
+            // Holds taken at a time count before those given back then
+            std::sort(changes.begin(), changes.end(), [](const auto& a, const auto& b) {
+                return a.first != b.first ? a.first < b.first : a.second > b.second;
+            });
+            int64_t held = 0;
+            for (const auto& [time, delta] : changes) {
+                held += delta;
+                if (held > hosts[h]->ram_capacity) {
+                    diverged[l] = 1;
+                    break;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+Replication from_engine(const TaskSimulator& sim, uint64_t seed) {
+    Replication replication;
+    replication.seed = seed;
+    replication.makespan = sim.makespan();
+    replication.records = sim.records();
+    for (const auto& record : replication.records) {
+        if (record.start >= 0 && record.finish >= 0) {
+            replication.busy_time += record.finish - record.start;
+        }
+    }
+    return replication;
+}
+
+} // namespace
+
+bool supports_lockstep(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks) {
+    if (config.admission != models::AdmissionPolicy::Fifo || config.speculation.enabled ||
+        config.autoscaling.enabled) {
+        return false;
+    }
+    return std::none_of(tasks.begin(), tasks.end(), [](const models::Task& task) { return task.pipelined(); });
+}
+
+std::vector<Replication> run_lockstep(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+                                      size_t replications) {
+    if (!supports_lockstep(config, tasks)) {
+        throw std::invalid_argument("Lockstep replications do not support DRF admission, speculation, "
+                                    "autoscaling or pipelined dependencies");
+    }
+
+    std::vector<Replication> results;
+    results.reserve(replications);
+    for (size_t first = 0; first < replications; first += W) {
+        size_t lanes = std::min(W, replications - first);
+        auto lane_config = [&](size_t lane) {
+            auto lane_config = config;
+            lane_config.stragglers.seed += first + lane;
+            return lane_config;
+        };
+
+        // Lane 0 runs on the engine and fixes the grant order
+        TaskSimulator reference(lane_config(0), std::vector<models::Task>(tasks));
+        reference.enable_grant_log();
+        reference.run();
+        const auto& resolved = reference.tasks();
+
+        // Execution times of the lanes, unused lanes repeat lane 0
+        std::vector<Lanes> exec_time(resolved.size());
+        for (size_t l = 0; l < W; ++l) {
+            auto lane_tasks = l < lanes ? lane_config(l).stragglers : lane_config(0).stragglers;
+            auto drawn = draw_stragglers(lane_tasks, resolved).exec_time;
+            for (size_t i = 0; i < resolved.size(); ++i) {
+                exec_time[i].at[l] = drawn[i];
+            }
+        }
+        auto replayed = replay(resolved, reference.hosts(), reference.grants(), exec_time);
+
+        // A replay of lane 0 that passes must reproduce the engine exactly
+        int64_t lane0_makespan = 0;
+        bool lane0_matches = true;
+        for (size_t i = 0; i < resolved.size() && !replayed.diverged[0]; ++i) {
+            const auto& record = reference.records()[i];
+            lane0_makespan = std::max(lane0_makespan, replayed.finish[i].at[0]);
+            lane0_matches &= record.start == replayed.start[i].at[0] && record.finish == replayed.finish[i].at[0];
+        }
+        if (!replayed.diverged[0] && (!lane0_matches || lane0_makespan != reference.makespan())) {
+            logger::warn("Lockstep replay disagrees with the engine for seed {}, running lanes on the engine",
+                         lane_config(0).stragglers.seed);
+            replayed.diverged.fill(1);
+        }
+
+        results.push_back(from_engine(reference, lane_config(0).stragglers.seed));
+        for (size_t l = 1; l < lanes; ++l) {
+            auto seeded = lane_config(l);
+            if (replayed.diverged[l]) {
+                TaskSimulator sim(seeded, std::vector<models::Task>(tasks));
+                sim.run();
+                results.push_back(from_engine(sim, seeded.stragglers.seed));
+                continue;
+            }
+            Replication replication;
+            replication.seed = seeded.stragglers.seed;
+            replication.lockstep = true;
+            replication.records.resize(resolved.size());
+            for (size_t i = 0; i < resolved.size(); ++i) {
+                auto& record = replication.records[i];
+                record.ready = replayed.ready[i].at[l];
+                record.start = replayed.start[i].at[l];
+                record.finish = replayed.finish[i].at[l];
+                record.phase = TaskPhase::Done;
+                replication.makespan = std::max(replication.makespan, record.finish);
+                replication.busy_time += record.finish - record.start;
+            }
+            results.push_back(std::move(replication));
+        }
+    }
+    return results;
+}
+
+} // namespace simulator
@@ -1,27 +1,465 @@
 // Main application for running task simulations using SimCpp20
 
 #include "simulator.hpp"
+#include "analysis.hpp"
+#include "calibration.hpp"
+#include "executor.hpp"
+#include "lockstep.hpp"
 #include "config_parser.h"
 #include "csv_parser.h"
 #include "logger.hpp"
+#include "metrics.hpp"
+#include "results.hpp"
+#include "sampling.hpp"
+#include "workloads.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <string>
 #include <cstring>
 #include <filesystem>
 #include <sstream>
+#include <optional>
+#include <cstdlib>
+#include <unistd.h>
 
 void print_usage(const char* program_name) {
     std::cout << "Task Simulator - Simulates task execution on multi-host system\n\n";
-    std::cout << "Usage: " << program_name << " <experiments_xml> --experiment <name> [options]\n\n";
+    std::cout << "Usage: " << program_name << " <experiments_xml> --experiment <name> [options]\n";
+    std::cout << "       " << program_name << " generate <kind> <num_tasks> <num_hosts> <out_dir>\n";
+    std::cout << "       " << program_name << " compare <baseline.result> <candidate.result> [--top N]\n";
+    std::cout << "       " << program_name << " batch <experiments_xml>... [-e NAME]... [--replications N] [--threads N]"
+                 " [--lockstep]\n";
+    std::cout << "       " << program_name << " analyze <task_rows> [--windows N] [--threads N]\n";
+    std::cout << "       " << program_name << " calibrate <experiments_xml> -e NAME --log PATH --out DIR"
+                 " [--iterations N] [--threads N]\n\n";
     std::cout << "Arguments:\n";
     std::cout << "  experiments_xml           Path to XML file containing experiment definitions\n";
     std::cout << "  --experiment, -e NAME     Experiment name to run\n\n";
     std::cout << "Options:\n";
     std::cout << "  --help, -h                Show this help message\n";
-    std::cout << "  --verbose, -v             Show detailed statistics\n\n";
+    std::cout << "  --verbose, -v             Show detailed statistics\n";
+    std::cout << "  --quiet, -q               Only log warnings and errors\n";
+    std::cout << "  --progress                Periodically report progress and ETA\n";
+    std::cout << "  --progress-interval MS    Progress reporting interval (default: 1000)\n";
+    std::cout << "  --metrics-file PATH       Periodically write Prometheus textfile metrics\n";
+    std::cout << "  --metrics-interval S      Metrics rewrite interval in seconds (default: 10)\n";
+    std::cout << "  --timeseries PATH         Write sampled resource levels (columnar binary)\n";
+    std::cout << "  --timeseries-interval T   Sampling interval in simulated time (default: 1)\n";
+    std::cout << "  --task-rows PATH          Stream per-task timings and waits from a writer thread\n";
+    std::cout << "  --task-rows-format F      csv (default) or columnar\n";
+    std::cout << "  --quantum Q               Approximate mode: end timed waits on the nearest multiple of Q\n";
+    std::cout << "  --sample P                Estimate: simulate one window in every P tasks in detail\n";
+    std::cout << "  --sample-window N         Tasks per detailed window (default: min(1000, P))\n";
+    std::cout << "  --sample-warmup N         Tasks at either end of a window not measured (default: 100)\n";
+    std::cout << "  --coarsen                 Simulate contention-free same-host chains as macro-tasks\n";
+    std::cout << "  --fast-exit               Exit without freeing simulation state once output is written\n";
+    std::cout << "  --result PATH             Write per-task timings and summary as a result file\n";
+    std::cout << "  --baseline PATH           Compare this run against an earlier result file\n\n";
+    std::cout << "Generate:\n";
+    std::cout << "  Writes <kind>.csv and <kind>.xml (experiment <kind>) to out_dir.\n";
+    std::cout << "  Kinds: chain, ping_pong, fan_out, ram_contended\n\n";
+    std::cout << "Compare:\n";
+    std::cout << "  Reports makespan, host utilization and critical path changes and the\n";
+    std::cout << "  N tasks whose finish time moved most (default: 10).\n\n";
+    std::cout << "Batch:\n";
+    std::cout << "  Runs every experiment of the given files (or only those named with -e),\n";
+    std::cout << "  N times each with straggler seeds seed..seed+N-1, on a shared work-stealing\n";
+    std::cout << "  pool of --threads workers (default: one per hardware thread). Prints one\n";
+    std::cout << "  summary row per run in argument order. --lockstep replays the replications\n";
+    std::cout << "  of an experiment " << simulator::kLockstepLanes
+              << " at a time from one engine run's grant order.\n\n";
+    std::cout << "Analyze:\n";
+    std::cout << "  Reads a columnar task row file (--task-rows-format columnar) and prints\n";
+    std::cout << "  wait-time histograms, per-host queue and response percentiles and busy\n";
+    std::cout << "  cores in N windows over the makespan (default: 20).\n\n";
     std::cout << "Examples:\n";
     std::cout << "  " << program_name << " experiments.xml --experiment simple\n";
     std::cout << "  " << program_name << " experiments.xml -e ping_pong --verbose\n";
+    std::cout << "  " << program_name << " generate fan_out 100000 16 workloads/\n";
+    std::cout << "  " << program_name << " experiments.xml -e simple --baseline before.result\n";
+    std::cout << "  " << program_name << " batch sweep.xml --replications 20 --threads 8\n";
+    std::cout << "  " << program_name << " analyze rows.bin --windows 50\n";
+}
+
+// Write a synthetic workload (tasks CSV plus a one-experiment XML)
+int run_generate(int argc, char* argv[]) {
+    if (argc != 6) {
+        throw std::invalid_argument("generate requires <kind> <num_tasks> <num_hosts> <out_dir>");
+    }
+
+    auto kind = workloads::parse_kind(argv[2]);
+    size_t num_tasks = std::stoul(argv[3]);
+    size_t num_hosts = std::stoul(argv[4]);
+    std::filesystem::path out_dir = argv[5];
+    std::filesystem::create_directories(out_dir);
+
+    std::string name = workloads::kind_name(kind);
+    auto config = workloads::generate_config(num_hosts);
+    auto tasks = workloads::generate_tasks(kind, num_tasks, num_hosts);
+
+    config.tasks_csv_path = name + ".csv";
+    parsers::write_tasks_csv((out_dir / config.tasks_csv_path).string(), tasks);
+    parsers::write_experiments_xml((out_dir / (name + ".xml")).string(), {{name, config}});
+
+    logger::info("Generated {} workload: {} tasks on {} hosts in {}", name, num_tasks, num_hosts,
+                 out_dir.string());
+    return 0;
+}
+
+// Compare two result files written with --result
+int run_compare(int argc, char* argv[]) {
+    size_t top_n = 10;
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--top") {
+            if (i + 1 < argc) {
+                top_n = std::stoul(argv[++i]);
+            } else {
+                throw std::invalid_argument("--top requires an argument");
+            }
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2) {
+        throw std::invalid_argument("compare requires <baseline.result> <candidate.result>");
+    }
+
+    auto comparison = simulator::compare_result_files(paths[0], paths[1], top_n);
+    std::cout << simulator::format_comparison(comparison) << "\n";
+    return 0;
+}
+
+// Outcome of one simulation run in batch mode
+struct BatchRun {
+    std::string experiment;
+    uint64_t seed = 0;
+    size_t tasks = 0;
+    int64_t makespan = 0;
+    double utilization = 0.0;  // Busy core time / core time of the hosts
+    double wall_ms = 0.0;
+    bool lockstep = false;  // Replayed in lockstep instead of run on the engine
+};
+
+BatchRun run_batch_job(const std::string& name, models::ExperimentConfig config,
+                       std::vector<models::Task> tasks) {
+    auto started = std::chrono::steady_clock::now();
+    BatchRun run;
+    run.experiment = name;
+    run.seed = config.stragglers.seed;
+    run.tasks = tasks.size();
+
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    sim.run();
+    run.makespan = sim.makespan();
+
+    int64_t busy = 0;
+    for (const auto& record : sim.records()) {
+        if (record.start >= 0 && record.finish >= 0) {
+            busy += record.finish - record.start;
+        }
+    }
+    int64_t core_time = 0;
+    for (size_t h = 0; h < sim.hosts().size(); ++h) {
+        core_time += sim.hosts()[h]->cpu_cores * sim.host_time(h);
+    }
+    if (core_time > 0) {
+        run.utilization = static_cast<double>(busy) / static_cast<double>(core_time);
+    }
+    run.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    return run;
+}
+
+// Summary rows of replications run in lockstep, sharing the group's wall time
+std::vector<BatchRun> run_lockstep_job(const std::string& name, const models::ExperimentConfig& config,
+                                       const std::vector<models::Task>& tasks, size_t replications) {
+    auto started = std::chrono::steady_clock::now();
+    auto replicated = simulator::run_lockstep(config, tasks, replications);
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    int64_t cores = 0;
+    for (const auto& [_, host] : config.hosts) {
+        cores += host.cpu_cores;
+    }
+    std::vector<BatchRun> runs;
+    for (const auto& replication : replicated) {
+        BatchRun run;
+        run.experiment = name;
+        run.seed = replication.seed;
+        run.tasks = tasks.size();
+        run.makespan = replication.makespan;
+        if (cores * replication.makespan > 0) {
+            run.utilization = static_cast<double>(replication.busy_time) /
+                              static_cast<double>(cores * replication.makespan);
+        }
+        run.wall_ms = wall_ms / static_cast<double>(replicated.size());
+        run.lockstep = replication.lockstep;
+        runs.push_back(run);
+    }
+    return runs;
+}
+
+// Run experiments (and replications of them) in parallel on one pool
+int run_batch(int argc, char* argv[]) {
+    std::vector<std::string> xml_files;
+    std::vector<std::string> names;
+    size_t replications = 1;
+    size_t threads = 0;
+    bool lockstep = false;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--lockstep") {
+            lockstep = true;
+        } else if (arg == "--experiment" || arg == "-e" || arg == "--replications" || arg == "--threads") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " requires an argument");
+            }
+            std::string value = argv[++i];
+            if (arg == "--replications" || arg == "--threads") {
+                auto number = std::stoul(value);
+                if (number == 0) {
+                    throw std::invalid_argument(arg + " must be > 0");
+                }
+                (arg == "--threads" ? threads : replications) = number;
+            } else {
+                names.push_back(value);
+            }
+        } else if (arg[0] != '-') {
+            xml_files.push_back(arg);
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    if (xml_files.empty()) {
+        throw std::invalid_argument("batch requires at least one <experiments_xml>");
+    }
+
+    // Experiments in argument order, by name within a file
+    std::vector<std::pair<std::string, models::ExperimentConfig>> experiments;
+    for (const auto& xml_file : xml_files) {
+        auto configs = parsers::load_experiments_from_xml(xml_file);
+        std::vector<std::string> selected;
+        for (const auto& [name, _] : configs) {
+            if (names.empty() || std::find(names.begin(), names.end(), name) != names.end()) {
+                selected.push_back(name);
+            }
+        }
+        std::sort(selected.begin(), selected.end());
+        for (const auto& name : selected) {
+            experiments.emplace_back(name, configs.at(name));
+        }
+    }
+    for (const auto& name : names) {
+        if (std::none_of(experiments.begin(), experiments.end(),
+                         [&name](const auto& experiment) { return experiment.first == name; })) {
+            throw std::invalid_argument("Experiment not found: " + name);
+        }
+    }
+
+    // Per-task logging from concurrent runs would interleave
+    logger::set_level(spdlog::level::warn);
+    simulator::WorkStealingPool pool(threads);
+
+    // Each tasks CSV is parsed once, however many runs share it
+    std::vector<std::string> csv_paths;
+    for (const auto& [_, config] : experiments) {
+        if (std::find(csv_paths.begin(), csv_paths.end(), config.tasks_csv_path) == csv_paths.end()) {
+            csv_paths.push_back(config.tasks_csv_path);
+        }
+    }
+    auto parsed = pool.map<std::vector<models::Task>>(csv_paths.size(), [&csv_paths](size_t i) {
+        auto tasks = parsers::parse_tasks_csv(csv_paths[i]);
+        parsers::validate_task_dependencies(tasks);
+        return tasks;
+    });
+    std::map<std::string, const std::vector<models::Task>*> tasks_by_path;
+    for (size_t i = 0; i < csv_paths.size(); ++i) {
+        tasks_by_path[csv_paths[i]] = &parsed[i];
+    }
+
+    pool.reset_stats();
+    auto started = std::chrono::steady_clock::now();
+    // One job per run, or per group of replications replayed in lockstep
+    struct Job {
+        size_t experiment;
+        size_t first;  // First replication
+        size_t count;
+    };
+    std::vector<Job> jobs;
+    for (size_t e = 0; e < experiments.size(); ++e) {
+        const auto& config = experiments[e].second;
+        bool grouped = lockstep && simulator::supports_lockstep(config, *tasks_by_path.at(config.tasks_csv_path));
+        size_t group = grouped ? simulator::kLockstepLanes : 1;
+        for (size_t first = 0; first < replications; first += group) {
+            jobs.push_back(Job{e, first, grouped ? std::min(group, replications - first) : 0});
+        }
+    }
+    auto job_runs = pool.map<std::vector<BatchRun>>(jobs.size(), [&](size_t j) {
+        const auto& job = jobs[j];
+        const auto& [name, base] = experiments[job.experiment];
+        auto config = base;
+        config.stragglers.seed += job.first;
+        const auto& tasks = *tasks_by_path.at(config.tasks_csv_path);
+        if (job.count > 0) {
+            return run_lockstep_job(name, config, tasks, job.count);
+        }
+        return std::vector<BatchRun>{run_batch_job(name, config, tasks)};
+    });
+    std::vector<BatchRun> runs;
+    for (auto& group : job_runs) {
+        runs.insert(runs.end(), group.begin(), group.end());
+    }
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+    std::cout << std::left << std::setw(28) << "EXPERIMENT" << std::right
+              << std::setw(10) << "SEED" << std::setw(12) << "TASKS" << std::setw(14) << "MAKESPAN"
+              << std::setw(10) << "UTIL" << std::setw(12) << "WALL_MS" << "\n";
+    for (const auto& run : runs) {
+        std::cout << std::left << std::setw(28) << run.experiment << std::right
+                  << std::setw(10) << run.seed << std::setw(12) << run.tasks
+                  << std::setw(14) << run.makespan << std::setw(10) << std::fixed << std::setprecision(3)
+                  << run.utilization << std::setw(12) << std::setprecision(1) << run.wall_ms << "\n";
+    }
+
+    if (replications > 1) {
+        std::cout << "\nMakespan over " << replications << " replications:\n";
+        for (size_t e = 0; e < experiments.size(); ++e) {
+            auto first = runs.begin() + e * replications;
+            auto [min, max] = std::minmax_element(first, first + replications,
+                [](const BatchRun& a, const BatchRun& b) { return a.makespan < b.makespan; });
+            double sum = 0.0;
+            for (auto it = first; it != first + replications; ++it) {
+                sum += it->makespan;
+            }
+            std::cout << "  " << experiments[e].first << ": mean " << std::setprecision(1)
+                      << sum / replications << ", min " << min->makespan << ", max " << max->makespan << "\n";
+        }
+    }
+
+    // Load balance: busy time of the busiest worker over the average
+    auto stats = pool.stats();
+    double busy_sum = 0.0;
+    double busy_max = 0.0;
+    uint64_t steals = 0;
+    for (const auto& worker : stats) {
+        double busy = std::chrono::duration<double, std::milli>(worker.busy).count();
+        busy_sum += busy;
+        busy_max = std::max(busy_max, busy);
+        steals += worker.steals;
+    }
+    double imbalance = busy_sum > 0.0 ? busy_max / (busy_sum / stats.size()) : 1.0;
+    if (lockstep) {
+        auto replayed = std::count_if(runs.begin(), runs.end(), [](const BatchRun& run) { return run.lockstep; });
+        std::cout << "\n" << replayed << " of " << runs.size() << " runs replayed in lockstep\n";
+    }
+
+    std::cout << "\n" << runs.size() << " runs on " << pool.size() << " workers in "
+              << std::setprecision(1) << wall_ms << " ms (" << steals << " steals, busiest worker "
+              << std::setprecision(2) << imbalance << "x average)\n";
+    return 0;
+}
+
+// Aggregate a columnar task row file
+int run_analyze(int argc, char* argv[]) {
+    std::string path;
+    size_t windows = 20;
+    size_t threads = 0;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--windows" || arg == "--threads") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " requires an argument");
+            }
+            auto number = std::stoul(argv[++i]);
+            if (number == 0) {
+                throw std::invalid_argument(arg + " must be > 0");
+            }
+            (arg == "--threads" ? threads : windows) = number;
+        } else if (arg[0] != '-' && path.empty()) {
+            path = arg;
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    if (path.empty()) {
+        throw std::invalid_argument("analyze requires <task_rows>");
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    auto data = simulator::read_task_rows(path);
+    auto loaded = std::chrono::steady_clock::now();
+    simulator::WorkStealingPool pool(threads);
+    auto analysis = simulator::analyze_task_rows(data, windows, pool);
+    auto finished = std::chrono::steady_clock::now();
+
+    // Bytes of the columns the scan reads: host (4) and eight times (8 each)
+    double bytes = static_cast<double>(analysis.rows) * (sizeof(uint32_t) + 8 * sizeof(int64_t));
+    double load_ms = std::chrono::duration<double, std::milli>(loaded - started).count();
+    double scan_ms = std::chrono::duration<double, std::milli>(finished - loaded).count();
+    std::cout << simulator::format_analysis(analysis) << "\n";
+    std::cout << "\nLoaded in " << std::fixed << std::setprecision(1) << load_ms << " ms, scanned "
+              << bytes / 1e6 << " MB in " << scan_ms << " ms (" << std::setprecision(2)
+              << (scan_ms > 0.0 ? bytes / 1e6 / scan_ms : 0.0) << " GB/s on " << pool.size() << " workers)\n";
+    return 0;
+}
+
+// Fit host speeds and link scales of one experiment to an observed log and
+// write the corrected experiment, its tasks and the per-task residuals
+int run_calibrate(int argc, char* argv[]) {
+    std::string xml_file;
+    std::string name;
+    std::string log_file;
+    std::string out_dir;
+    simulator::CalibrationOptions options;
+    size_t threads = 0;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--experiment" || arg == "-e" || arg == "--log" || arg == "--out") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " requires an argument");
+            }
+            (arg == "--log" ? log_file : arg == "--out" ? out_dir : name) = argv[++i];
+        } else if (arg == "--iterations" || arg == "--threads") {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(arg + " requires an argument");
+            }
+            (arg == "--threads" ? threads : options.max_iterations) = std::stoul(argv[++i]);
+        } else if (arg[0] != '-' && xml_file.empty()) {
+            xml_file = arg;
+        } else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    if (xml_file.empty() || name.empty() || log_file.empty() || out_dir.empty()) {
+        throw std::invalid_argument("calibrate requires <experiments_xml>, --experiment, --log and --out");
+    }
+
+    auto config = parsers::get_experiment_config(parsers::load_experiments_from_xml(xml_file), name);
+    auto tasks = parsers::parse_tasks_csv(config.tasks_csv_path);
+    parsers::validate_task_dependencies(tasks);
+    auto observed = simulator::parse_observed_log(log_file);
+    logger::info("Calibrating {} against {} observed tasks...", name, observed.size());
+
+    // Per-task logging from concurrent simulations would interleave
+    auto log_level = spdlog::get_level();
+    logger::set_level(spdlog::level::warn);
+    simulator::WorkStealingPool pool(threads);
+    auto calibration = simulator::calibrate(config, tasks, observed, options, pool);
+    logger::set_level(log_level);
+    std::cout << simulator::format_calibration(calibration) << "\n";
+
+    std::filesystem::path out = out_dir;
+    std::filesystem::create_directories(out);
+    calibration.config.tasks_csv_path = name + ".csv";
+    parsers::write_tasks_csv((out / calibration.config.tasks_csv_path).string(), tasks);
+    parsers::write_experiments_xml((out / (name + ".xml")).string(), {{name, calibration.config}});
+    simulator::write_residuals_csv((out / (name + "_residuals.csv")).string(), calibration);
+    logger::info("Wrote calibrated experiment, tasks and residuals to {}", out.string());
+    return 0;
 }
 
 struct Args {
@@ -29,6 +467,21 @@ struct Args {
     std::string experiment_name;
     bool show_help = false;
     bool verbose = false;
+    bool quiet = false;
+    bool progress = false;
+    int progress_interval_ms = 1000;
+    std::string metrics_file;
+    double metrics_interval_s = 10.0;
+    std::string timeseries_file;
+    int64_t timeseries_interval = 1;
+    std::string task_rows_file;
+    simulator::TaskRowFormat task_rows_format = simulator::TaskRowFormat::Csv;
+    std::string result_file;
+    std::string baseline_file;
+    int64_t quantum = 0;
+    bool coarsen = false;
+    simulator::SamplingConfig sampling{0, 0, 100};  // Period 0 = full run, window 0 = default
+    bool fast_exit = false;
 };
 
 Args parse_arguments(int argc, char* argv[]) {
@@ -46,6 +499,101 @@ Args parse_arguments(int argc, char* argv[]) {
             return args;
         } else if (arg == "--verbose" || arg == "-v") {
             args.verbose = true;
+        } else if (arg == "--quiet" || arg == "-q") {
+            args.quiet = true;
+        } else if (arg == "--sample" || arg == "--sample-window" || arg == "--sample-warmup") {
+            if (i + 1 < argc) {
+                auto number = std::stoul(argv[++i]);
+                (arg == "--sample" ? args.sampling.period
+                 : arg == "--sample-window" ? args.sampling.window : args.sampling.warmup) = number;
+            } else {
+                throw std::invalid_argument(arg + " requires an argument");
+            }
+        } else if (arg == "--coarsen") {
+            args.coarsen = true;
+        } else if (arg == "--fast-exit") {
+            args.fast_exit = true;
+        } else if (arg == "--progress") {
+            args.progress = true;
+        } else if (arg == "--progress-interval") {
+            if (i + 1 < argc) {
+                args.progress_interval_ms = std::stoi(argv[++i]);
+                if (args.progress_interval_ms <= 0) {
+                    throw std::invalid_argument("--progress-interval must be > 0");
+                }
+            } else {
+                throw std::invalid_argument("--progress-interval requires an argument");
+            }
+        } else if (arg == "--metrics-file") {
+            if (i + 1 < argc) {
+                args.metrics_file = argv[++i];
+            } else {
+                throw std::invalid_argument("--metrics-file requires an argument");
+            }
+        } else if (arg == "--metrics-interval") {
+            if (i + 1 < argc) {
+                args.metrics_interval_s = std::stod(argv[++i]);
+                if (args.metrics_interval_s <= 0) {
+                    throw std::invalid_argument("--metrics-interval must be > 0");
+                }
+            } else {
+                throw std::invalid_argument("--metrics-interval requires an argument");
+            }
+        } else if (arg == "--timeseries") {
+            if (i + 1 < argc) {
+                args.timeseries_file = argv[++i];
+            } else {
+                throw std::invalid_argument("--timeseries requires an argument");
+            }
+        } else if (arg == "--timeseries-interval") {
+            if (i + 1 < argc) {
+                args.timeseries_interval = std::stoll(argv[++i]);
+                if (args.timeseries_interval <= 0) {
+                    throw std::invalid_argument("--timeseries-interval must be > 0");
+                }
+            } else {
+                throw std::invalid_argument("--timeseries-interval requires an argument");
+            }
+        } else if (arg == "--task-rows") {
+            if (i + 1 < argc) {
+                args.task_rows_file = argv[++i];
+            } else {
+                throw std::invalid_argument("--task-rows requires an argument");
+            }
+        } else if (arg == "--task-rows-format") {
+            if (i + 1 < argc) {
+                std::string format = argv[++i];
+                if (format == "csv") {
+                    args.task_rows_format = simulator::TaskRowFormat::Csv;
+                } else if (format == "columnar") {
+                    args.task_rows_format = simulator::TaskRowFormat::Columnar;
+                } else {
+                    throw std::invalid_argument("--task-rows-format must be csv or columnar, got: " + format);
+                }
+            } else {
+                throw std::invalid_argument("--task-rows-format requires an argument");
+            }
+        } else if (arg == "--quantum") {
+            if (i + 1 < argc) {
+                args.quantum = std::stoll(argv[++i]);
+                if (args.quantum <= 0) {
+                    throw std::invalid_argument("--quantum must be > 0");
+                }
+            } else {
+                throw std::invalid_argument("--quantum requires an argument");
+            }
+        } else if (arg == "--result") {
+            if (i + 1 < argc) {
+                args.result_file = argv[++i];
+            } else {
+                throw std::invalid_argument("--result requires an argument");
+            }
+        } else if (arg == "--baseline") {
+            if (i + 1 < argc) {
+                args.baseline_file = argv[++i];
+            } else {
+                throw std::invalid_argument("--baseline requires an argument");
+            }
         } else if (arg == "--experiment" || arg == "-e") {
             if (i + 1 < argc) {
                 args.experiment_name = argv[++i];
@@ -72,7 +620,26 @@ int main(int argc, char* argv[]) {
     logger::init();
 
     try {
+        if (argc > 1 && std::strcmp(argv[1], "generate") == 0) {
+            return run_generate(argc, argv);
+        }
+        if (argc > 1 && std::strcmp(argv[1], "compare") == 0) {
+            return run_compare(argc, argv);
+        }
+        if (argc > 1 && std::strcmp(argv[1], "batch") == 0) {
+            return run_batch(argc, argv);
+        }
+        if (argc > 1 && std::strcmp(argv[1], "analyze") == 0) {
+            return run_analyze(argc, argv);
+        }
+        if (argc > 1 && std::strcmp(argv[1], "calibrate") == 0) {
+            return run_calibrate(argc, argv);
+        }
+
         auto args = parse_arguments(argc, argv);
+        if (args.quiet) {
+            logger::set_level(spdlog::level::warn);
+        }
 
         if (args.show_help || args.xml_file.empty() || args.experiment_name.empty()) {
             print_usage(argv[0]);
@@ -98,10 +665,21 @@ int main(int argc, char* argv[]) {
         for (const auto& [host_id, host_cfg] : experiment.hosts) {
             if (!first) hosts_info << "; ";
             hosts_info << host_id << " (" << host_cfg.cpu_cores << " cores, "
-                      << host_cfg.ram << " RAM)";
+                      << host_cfg.ram << " RAM";
+            if (host_cfg.speed != 1.0) {
+                hosts_info << ", speed " << host_cfg.speed;
+            }
+            hosts_info << ")";
             first = false;
         }
         logger::info("  Hosts: {}", hosts_info.str());
+        if (experiment.autoscaling.enabled) {
+            const auto& scaling = experiment.autoscaling;
+            logger::info("  Autoscaling pool {}: {}-{} hosts ({} cores, {} RAM), interval {}, cooldown {}, "
+                         "provisioning delay {}", scaling.pool, scaling.min_hosts, scaling.max_hosts,
+                         scaling.host.cpu_cores, scaling.host.ram, scaling.interval, scaling.cooldown,
+                         scaling.provisioning_delay);
+        }
 
         // Step 2: Parse tasks from CSV (path from experiment config)
         logger::info("Parsing tasks from CSV: {}", experiment.tasks_csv_path);
@@ -113,15 +691,109 @@ int main(int argc, char* argv[]) {
         parsers::validate_task_dependencies(tasks);
         logger::info("Dependencies validated successfully");
 
+        // Sampled estimate instead of a full run
+        if (args.sampling.period > 0) {
+            if (args.sampling.window == 0) {
+                args.sampling.window = std::min<size_t>(1000, args.sampling.period);
+            }
+            if (!args.timeseries_file.empty() || !args.task_rows_file.empty() || !args.result_file.empty() ||
+                !args.baseline_file.empty() || args.quantum > 0 || args.coarsen) {
+                throw std::invalid_argument("--sample cannot be combined with per-task output, --quantum or --coarsen");
+            }
+            logger::info("Sampling {} tasks: {} in detail every {} ({} warm-up)...",
+                         tasks.size(), args.sampling.window, args.sampling.period, args.sampling.warmup);
+            // Per-task logging from concurrent windows would interleave
+            auto log_level = spdlog::get_level();
+            logger::set_level(spdlog::level::warn);
+            simulator::WorkStealingPool pool;
+            auto sampled = simulator::run_sampled(experiment, tasks, args.sampling, pool);
+            logger::set_level(log_level);
+
+            logger::info("======================================================================");
+            logger::info("Sampled {} windows, {} of {} tasks in detail ({:.1f}x fewer)", sampled.windows,
+                         sampled.detailed_tasks, sampled.tasks,
+                         static_cast<double>(sampled.tasks) / static_cast<double>(sampled.detailed_tasks));
+            logger::info("Estimated makespan:     {:.0f} (95% CI {:.0f} - {:.0f})", sampled.makespan.estimate,
+                         sampled.makespan.low, sampled.makespan.high);
+            logger::info("Estimated utilization:  {:.2f}% (95% CI {:.2f}% - {:.2f}%)",
+                         sampled.utilization.estimate, sampled.utilization.low, sampled.utilization.high);
+            logger::info("======================================================================");
+            return 0;
+        }
+
         // Step 4: Run simulation
         logger::info("Initializing simulator...");
         simulator::TaskSimulator sim(experiment, std::move(tasks));
 
+        if (!args.timeseries_file.empty()) {
+            sim.enable_timeseries();
+        }
+        if (args.quantum > 0) {
+            sim.set_quantum(args.quantum);
+        }
+        if (!args.task_rows_file.empty()) {
+            sim.enable_task_rows(args.task_rows_file, args.task_rows_format);
+        }
+        if (args.coarsen) {
+            sim.enable_coarsening();
+        }
+
+        std::optional<simulator::ProgressReporter> progress;
+        if (args.progress) {
+            progress.emplace(sim.counters(), std::chrono::milliseconds(args.progress_interval_ms));
+        }
+
+        std::optional<simulator::MetricsExporter> metrics;
+        if (!args.metrics_file.empty()) {
+            auto interval = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::duration<double>(args.metrics_interval_s));
+            metrics.emplace(sim.counters(), args.metrics_file, interval);
+        }
+
+        // SIGUSR1 logs a state dump at the next safe point between events
+        simulator::install_state_dump_handler();
+
         logger::info("Starting simulation...");
         sim.run(args.verbose);
+        progress.reset();
+        metrics.reset();
+
+        if (!args.timeseries_file.empty()) {
+            sim.write_timeseries(args.timeseries_file, args.timeseries_interval);
+        }
+
+        // The comparison streams both sides from disk, so an inline baseline
+        // comparison goes through a (temporary) result file as well
+        std::string result_file = args.result_file;
+        if (result_file.empty() && !args.baseline_file.empty()) {
+            result_file = (std::filesystem::temp_directory_path() /
+                           ("task_simulator_" + std::to_string(getpid()) + ".result")).string();
+        }
+        if (!result_file.empty()) {
+            simulator::write_result_file(result_file, sim);
+            if (!args.result_file.empty()) {
+                logger::info("Wrote result file {}", result_file);
+            }
+        }
+        if (!args.baseline_file.empty()) {
+            auto comparison = simulator::compare_result_files(args.baseline_file, result_file);
+            if (args.result_file.empty()) {
+                std::filesystem::remove(result_file);
+            }
+            std::cout << "Comparison against " << args.baseline_file << ":\n"
+                      << simulator::format_comparison(comparison) << "\n";
+        }
 
         logger::info("Simulation completed successfully!");
 
+        // Everything is written; tearing down millions of tasks, events and
+        // coroutine frames would only delay the exit
+        if (args.fast_exit) {
+            std::cout.flush();
+            logger::flush();
+            std::_Exit(0);
+        }
+
         return 0;
 
     } catch (const std::exception& e) {
@@ -0,0 +1,105 @@
+#include "../include/metrics.hpp"
+#include "../include/logger.hpp"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace simulator {
+
+int64_t current_rss_bytes() {
+    // Second field of /proc/self/statm is the resident page count
+    std::ifstream statm("/proc/self/statm");
+    int64_t total_pages = 0;
+    int64_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages)) {
+        return 0;
+    }
+    return resident_pages * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::string format_prometheus(const CountersSnapshot& snapshot, int64_t rss_bytes) {
+    std::string out;
+    auto metric = [&out](const char* name, const char* type, const char* help) {
+        out += fmt::format("# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    };
+
+    int64_t cpu_waiting = 0;
+    int64_t ram_waiting = 0;
+    for (const auto& host : snapshot.hosts) {
+        cpu_waiting += host.cpu_waiting;
+        ram_waiting += host.ram_waiting;
+    }
+
+    metric("task_simulator_events_total", "counter", "Events processed by the simulation engine.");
+    out += fmt::format("task_simulator_events_total {}\n", snapshot.events);
+    metric("task_simulator_tasks_completed_total", "counter", "Tasks that finished execution.");
+    out += fmt::format("task_simulator_tasks_completed_total {}\n", snapshot.tasks_completed);
+    metric("task_simulator_tasks", "gauge", "Tasks in the simulated workload.");
+    out += fmt::format("task_simulator_tasks {}\n", snapshot.tasks_total);
+    metric("task_simulator_sim_time", "gauge", "Current simulated time.");
+    out += fmt::format("task_simulator_sim_time {}\n", snapshot.sim_time);
+    metric("task_simulator_finished", "gauge", "1 once the simulation has finished.");
+    out += fmt::format("task_simulator_finished {}\n", snapshot.finished ? 1 : 0);
+    metric("task_simulator_queue_size", "gauge", "Tasks waiting for a resource.");
+    out += fmt::format("task_simulator_queue_size{{resource=\"cpu\"}} {}\n", cpu_waiting);
+    out += fmt::format("task_simulator_queue_size{{resource=\"ram\"}} {}\n", ram_waiting);
+    metric("task_simulator_resident_memory_bytes", "gauge", "Resident set size of the simulator process.");
+    out += fmt::format("task_simulator_resident_memory_bytes {}\n", rss_bytes);
+
+    metric("task_simulator_host_cpu_cores", "gauge", "CPU cores of the simulated host.");
+    for (const auto& host : snapshot.hosts) {
+        out += fmt::format("task_simulator_host_cpu_cores{{host=\"{}\"}} {}\n", host.name, host.cpu_cores);
+    }
+    metric("task_simulator_host_cpu_busy", "gauge", "Busy CPU cores of the simulated host.");
+    for (const auto& host : snapshot.hosts) {
+        out += fmt::format("task_simulator_host_cpu_busy{{host=\"{}\"}} {}\n", host.name, host.cpu_busy);
+    }
+    metric("task_simulator_host_cpu_waiting", "gauge", "Tasks waiting for a CPU core on the simulated host.");
+    for (const auto& host : snapshot.hosts) {
+        out += fmt::format("task_simulator_host_cpu_waiting{{host=\"{}\"}} {}\n", host.name, host.cpu_waiting);
+    }
+    metric("task_simulator_host_ram_level", "gauge", "Available RAM of the simulated host.");
+    for (const auto& host : snapshot.hosts) {
+        out += fmt::format("task_simulator_host_ram_level{{host=\"{}\"}} {}\n", host.name, host.ram_level);
+    }
+    metric("task_simulator_host_ram_waiting", "gauge", "Tasks waiting for RAM on the simulated host.");
+    for (const auto& host : snapshot.hosts) {
+        out += fmt::format("task_simulator_host_ram_waiting{{host=\"{}\"}} {}\n", host.name, host.ram_waiting);
+    }
+
+    return out;
+}
+
+// MetricsExporter implementation
+
+MetricsExporter::MetricsExporter(const EngineCounters& counters, std::string path,
+                                 std::chrono::milliseconds interval)
+    : counters_(counters),
+      path_(std::move(path)),
+      sampler_(interval, [this] {
+          try {
+              write_now();
+          } catch (const std::exception& e) {
+              logger::warn("Metrics export failed: {}", e.what());
+          }
+      }) {}
+
+void MetricsExporter::write_now() {
+    auto content = format_prometheus(take_snapshot(counters_), current_rss_bytes());
+
+    std::string tmp_path = path_ + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open metrics file: " + tmp_path);
+        }
+        file << content;
+        if (!file) {
+            throw std::runtime_error("Failed to write metrics file: " + tmp_path);
+        }
+    }
+    std::filesystem::rename(tmp_path, path_);
+}
+
+} // namespace simulator
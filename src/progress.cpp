@@ -0,0 +1,92 @@
+#include "../include/progress.hpp"
+#include "../include/logger.hpp"
+
+namespace simulator {
+
+CountersSnapshot take_snapshot(const EngineCounters& counters) {
+    CountersSnapshot snapshot;
+    snapshot.taken_at = std::chrono::steady_clock::now();
+    snapshot.sim_time = counters.sim_time.load(std::memory_order_relaxed);
+    snapshot.events = counters.events.load(std::memory_order_relaxed);
+    snapshot.tasks_completed = counters.tasks_completed.load(std::memory_order_relaxed);
+    snapshot.tasks_total = counters.tasks_total.load(std::memory_order_relaxed);
+    snapshot.finished = counters.finished.load(std::memory_order_relaxed);
+
+    snapshot.hosts.reserve(counters.hosts.size());
+    for (const auto& host : counters.hosts) {
+        snapshot.hosts.push_back(HostSnapshot{
+            host.name,
+            host.cpu_cores,
+            host.cpu_busy.load(std::memory_order_relaxed),
+            host.cpu_waiting.load(std::memory_order_relaxed),
+            host.ram_level.load(std::memory_order_relaxed),
+            host.ram_waiting.load(std::memory_order_relaxed)
+        });
+    }
+    return snapshot;
+}
+
+std::string format_progress(const CountersSnapshot& previous, const CountersSnapshot& current) {
+    double seconds = std::chrono::duration<double>(current.taken_at - previous.taken_at).count();
+    double event_rate = seconds > 0 ? (current.events - previous.events) / seconds : 0.0;
+    double task_rate = seconds > 0 ? (current.tasks_completed - previous.tasks_completed) / seconds : 0.0;
+
+    double percent = current.tasks_total > 0
+        ? 100.0 * current.tasks_completed / current.tasks_total
+        : 100.0;
+
+    std::string eta = "n/a";
+    uint64_t remaining = current.tasks_total - current.tasks_completed;
+    if (current.finished || remaining == 0) {
+        eta = "0s";
+    } else if (task_rate > 0) {
+        eta = fmt::format("{:.0f}s", remaining / task_rate);
+    }
+
+    return fmt::format("[PROGRESS]\t[t={}]\tevents {} ({:.0f}/s), tasks {}/{} ({:.1f}%), ETA {}",
+                       current.sim_time, current.events, event_rate,
+                       current.tasks_completed, current.tasks_total, percent, eta);
+}
+
+// PeriodicSampler implementation
+
+PeriodicSampler::PeriodicSampler(std::chrono::milliseconds interval, std::function<void()> tick)
+    : interval_(interval), tick_(std::move(tick)), thread_(&PeriodicSampler::loop, this) {}
+
+PeriodicSampler::~PeriodicSampler() {
+    stop();
+}
+
+void PeriodicSampler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void PeriodicSampler::loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        wake_.wait_for(lock, interval_, [this] { return stopping_; });
+        tick_();
+    }
+}
+
+// ProgressReporter implementation
+
+ProgressReporter::ProgressReporter(const EngineCounters& counters, std::chrono::milliseconds interval)
+    : counters_(counters),
+      previous_(take_snapshot(counters)),
+      sampler_(interval, [this] { tick(); }) {}
+
+void ProgressReporter::tick() {
+    auto current = take_snapshot(counters_);
+    logger::info("{}", format_progress(previous_, current));
+    previous_ = std::move(current);
+}
+
+} // namespace simulator
@@ -0,0 +1,381 @@
+#include "../include/results.hpp"
+#include "../include/simulator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace simulator {
+
+// File layout (text):
+//   # task_simulator result v1
+//   MAKESPAN,<time>
+//   CRITICAL_PATH,<run>,<network>,<wait>,<sleep>
+//   HOST,<name>,<cpu_cores>,<cpu_work>,<utilization %>   (one per host)
+//   TASK_NAME,TASK_HOST,READY,START,FINISH,CRITICAL     (column header)
+//   one row per task, sorted by task name (byte order)
+static const char* kResultMagic = "# task_simulator result v1";
+static const char* kTaskHeader = "TASK_NAME,TASK_HOST,READY,START,FINISH,CRITICAL";
+
+CriticalPathComposition critical_path(const std::vector<models::Task>& tasks,
+                                      const std::vector<TaskRecord>& records,
+                                      std::vector<bool>& on_path) {
+    CriticalPathComposition composition;
+    on_path.assign(tasks.size(), false);
+
+    size_t current = SIZE_MAX;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (records[i].finish >= 0 && (current == SIZE_MAX || records[i].finish >= records[current].finish)) {
+            current = i;
+        }
+    }
+    if (current == SIZE_MAX) {
+        return composition;
+    }
+
+    // Finished tasks ordered by (host, finish) to find the release that
+    // admitted a waiting task
+    std::vector<size_t> by_release;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (records[i].finish >= 0) by_release.push_back(i);
+    }
+    auto release_key = [&](size_t i) { return std::make_pair(tasks[i].host_index, records[i].finish); };
+    std::sort(by_release.begin(), by_release.end(), [&](size_t a, size_t b) {
+        return release_key(a) < release_key(b);
+    });
+
+    while (current != SIZE_MAX) {
+        on_path[current] = true;
+        const auto& task = tasks[current];
+        const auto& record = records[current];
+        composition.run += record.finish - record.start;
+        size_t next = SIZE_MAX;
+
+        if (record.start > record.ready) {
+            auto key = std::make_pair(task.host_index, record.start);
+            auto it = std::lower_bound(by_release.begin(), by_release.end(), key,
+                [&](size_t i, const auto& k) { return release_key(i) < k; });
+            for (; it != by_release.end() && release_key(*it) == key; ++it) {
+                if (!on_path[*it]) {
+                    next = *it;
+                    break;
+                }
+            }
+            if (next != SIZE_MAX) {
+                current = next;
+                continue;
+            }
+            composition.wait += record.start - record.ready;
+        }
+
+        // Ready time was set by the last dependency to arrive, or by the sleep
+        int64_t arrival = 0;
+        for (size_t dep : task.dependency_indices) {
+            if (records[dep].finish >= arrival && !on_path[dep]) {
+                arrival = records[dep].finish;
+                next = dep;
+            }
+        }
+        if (next != SIZE_MAX && arrival >= task.initial_sleep_time) {
+            composition.network += record.ready - arrival;
+        } else {
+            next = SIZE_MAX;
+            composition.sleep += std::min<int64_t>(task.initial_sleep_time, record.ready);
+            composition.network += std::max<int64_t>(0, record.ready - task.initial_sleep_time);
+        }
+        current = next;
+    }
+    return composition;
+}
+
+void write_result_file(const std::string& path, const TaskSimulator& sim) {
+    const auto& tasks = sim.tasks();
+    const auto& records = sim.records();
+    const auto& hosts = sim.hosts();
+
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write result file: " + path);
+    }
+
+    std::vector<bool> on_path;
+    auto composition = critical_path(tasks, records, on_path);
+
+    std::vector<int64_t> host_work(hosts.size(), 0);
+    for (const auto& task : tasks) {
+        host_work[task.host_index] += task.exec_time;
+    }
+
+    out << kResultMagic << "\n";
+    out << "MAKESPAN," << sim.makespan() << "\n";
+    out << "CRITICAL_PATH," << composition.run << "," << composition.network << ","
+        << composition.wait << "," << composition.sleep << "\n";
+    out << std::fixed << std::setprecision(4);
+    for (size_t h = 0; h < hosts.size(); ++h) {
+        int64_t available = static_cast<int64_t>(hosts[h]->cpu_cores) * sim.host_time(h);
+        double utilization = available > 0 ? 100.0 * host_work[h] / available : 0.0;
+        out << "HOST," << hosts[h]->name << "," << hosts[h]->cpu_cores << ","
+            << host_work[h] << "," << utilization << "\n";
+    }
+
+    std::vector<size_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return tasks[a].name < tasks[b].name;
+    });
+
+    out << kTaskHeader << "\n";
+    for (size_t i : order) {
+        const auto& record = records[i];
+        out << tasks[i].name << "," << tasks[i].host << "," << record.ready << ","
+            << record.start << "," << record.finish << "," << (on_path[i] ? 1 : 0) << "\n";
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed writing result file: " + path);
+    }
+}
+
+namespace {
+
+std::vector<std::string> split_fields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+struct ResultRow {
+    std::string name;
+    int64_t finish = -1;
+    bool critical = false;
+};
+
+// Streams one result file: summary lines are read eagerly, task rows one
+// at a time
+class ResultReader {
+public:
+    explicit ResultReader(const std::string& path) : path_(path), in_(path) {
+        if (!in_) {
+            throw std::runtime_error("Cannot open result file: " + path);
+        }
+
+        std::string line;
+        if (!std::getline(in_, line) || line != kResultMagic) {
+            throw std::runtime_error("Not a task_simulator result file: " + path);
+        }
+        while (std::getline(in_, line)) {
+            ++line_number_;
+            if (line == kTaskHeader) {
+                return;
+            }
+            auto fields = split_fields(line);
+            if (fields.size() == 2 && fields[0] == "MAKESPAN") {
+                makespan = std::stoll(fields[1]);
+            } else if (fields.size() == 5 && fields[0] == "CRITICAL_PATH") {
+                critical.run = std::stoll(fields[1]);
+                critical.network = std::stoll(fields[2]);
+                critical.wait = std::stoll(fields[3]);
+                critical.sleep = std::stoll(fields[4]);
+            } else if (fields.size() == 5 && fields[0] == "HOST") {
+                hosts.emplace_back(fields[1], std::stod(fields[4]));
+            } else {
+                fail("unexpected line");
+            }
+        }
+        fail("missing task rows header");
+    }
+
+    // Next task row; false at end of file
+    bool next(ResultRow& row) {
+        std::string line;
+        if (!std::getline(in_, line)) {
+            return false;
+        }
+        ++line_number_;
+        auto fields = split_fields(line);
+        if (fields.size() != 6) {
+            fail("expected 6 fields");
+        }
+        if (has_previous_ && !(previous_ < fields[0])) {
+            fail("task rows not sorted by name");
+        }
+        row.name = fields[0];
+        row.finish = std::stoll(fields[4]);
+        row.critical = fields[5] == "1";
+        previous_ = row.name;
+        has_previous_ = true;
+        return true;
+    }
+
+    int64_t makespan = 0;
+    CriticalPathComposition critical;
+    std::vector<std::pair<std::string, double>> hosts;
+
+private:
+    [[noreturn]] void fail(const std::string& reason) const {
+        throw std::runtime_error("Invalid result file " + path_ + " at line " +
+                                 std::to_string(line_number_ + 1) + ": " + reason);
+    }
+
+    std::string path_;
+    std::ifstream in_;
+    size_t line_number_ = 0;
+    std::string previous_;
+    bool has_previous_ = false;
+};
+
+} // namespace
+
+ResultComparison compare_result_files(const std::string& path_a, const std::string& path_b,
+                                      size_t top_n) {
+    ResultReader a(path_a);
+    ResultReader b(path_b);
+
+    ResultComparison comparison;
+    comparison.makespan_a = a.makespan;
+    comparison.makespan_b = b.makespan;
+    comparison.critical_a = a.critical;
+    comparison.critical_b = b.critical;
+
+    // Hosts: few, merge by name
+    std::sort(a.hosts.begin(), a.hosts.end());
+    std::sort(b.hosts.begin(), b.hosts.end());
+    size_t ha = 0, hb = 0;
+    while (ha < a.hosts.size() || hb < b.hosts.size()) {
+        if (hb == b.hosts.size() || (ha < a.hosts.size() && a.hosts[ha].first < b.hosts[hb].first)) {
+            comparison.hosts.push_back({a.hosts[ha].first, a.hosts[ha].second, 0.0});
+            ++ha;
+        } else if (ha == a.hosts.size() || b.hosts[hb].first < a.hosts[ha].first) {
+            comparison.hosts.push_back({b.hosts[hb].first, 0.0, b.hosts[hb].second});
+            ++hb;
+        } else {
+            comparison.hosts.push_back({a.hosts[ha].first, a.hosts[ha].second, b.hosts[hb].second});
+            ++ha;
+            ++hb;
+        }
+    }
+
+    // Tasks: sorted-merge join, keeping the top_n moves in a min-heap
+    auto smaller_move = [](const TaskFinishDelta& x, const TaskFinishDelta& y) {
+        return std::llabs(x.delta()) > std::llabs(y.delta());
+    };
+    std::priority_queue<TaskFinishDelta, std::vector<TaskFinishDelta>, decltype(smaller_move)> moves(smaller_move);
+
+    auto note_critical = [top_n](size_t& count, std::vector<std::string>& examples, const std::string& name) {
+        ++count;
+        if (examples.size() < top_n) examples.push_back(name);
+    };
+
+    ResultRow row_a, row_b;
+    bool has_a = a.next(row_a);
+    bool has_b = b.next(row_b);
+    while (has_a || has_b) {
+        if (!has_b || (has_a && row_a.name < row_b.name)) {
+            ++comparison.only_in_a;
+            has_a = a.next(row_a);
+        } else if (!has_a || row_b.name < row_a.name) {
+            ++comparison.only_in_b;
+            has_b = b.next(row_b);
+        } else {
+            ++comparison.matched_tasks;
+            if (row_a.critical && !row_b.critical) {
+                note_critical(comparison.left_critical_path, comparison.left_critical_examples, row_a.name);
+            } else if (!row_a.critical && row_b.critical) {
+                note_critical(comparison.joined_critical_path, comparison.joined_critical_examples, row_b.name);
+            }
+            if (top_n > 0 && row_a.finish >= 0 && row_b.finish >= 0 && row_a.finish != row_b.finish) {
+                TaskFinishDelta move{row_a.name, row_a.finish, row_b.finish};
+                if (moves.size() < top_n) {
+                    moves.push(std::move(move));
+                } else if (smaller_move(move, moves.top())) {
+                    moves.pop();
+                    moves.push(std::move(move));
+                }
+            }
+            has_a = a.next(row_a);
+            has_b = b.next(row_b);
+        }
+    }
+
+    while (!moves.empty()) {
+        comparison.largest_moves.push_back(moves.top());
+        moves.pop();
+    }
+    std::reverse(comparison.largest_moves.begin(), comparison.largest_moves.end());
+    return comparison;
+}
+
+std::string format_comparison(const ResultComparison& comparison) {
+    std::ostringstream out;
+    auto signed_value = [](int64_t value) {
+        std::string text = value > 0 ? "+" : "";
+        text += std::to_string(value);
+        return text;
+    };
+
+    int64_t makespan_delta = comparison.makespan_b - comparison.makespan_a;
+    out << "Makespan:               " << comparison.makespan_a << " -> " << comparison.makespan_b
+        << " (" << signed_value(makespan_delta);
+    if (comparison.makespan_a > 0) {
+        out << ", " << std::showpos << std::fixed << std::setprecision(2)
+            << 100.0 * makespan_delta / comparison.makespan_a << "%" << std::noshowpos;
+    }
+    out << ")\n";
+    out << "Tasks:                  " << comparison.matched_tasks << " matched, "
+        << comparison.only_in_a << " only in baseline, " << comparison.only_in_b << " only in candidate\n";
+
+    out << "Host utilization:\n";
+    for (const auto& host : comparison.hosts) {
+        out << "  " << host.name << ": " << std::fixed << std::setprecision(2)
+            << host.utilization_a << "% -> " << host.utilization_b << "% ("
+            << std::showpos << host.utilization_b - host.utilization_a << std::noshowpos << " pp)\n";
+    }
+
+    out << "Largest finish time moves:\n";
+    if (comparison.largest_moves.empty()) {
+        out << "  (none)\n";
+    }
+    for (const auto& move : comparison.largest_moves) {
+        out << "  " << move.name << ": " << move.finish_a << " -> " << move.finish_b
+            << " (" << signed_value(move.delta()) << ")\n";
+    }
+
+    const auto& a = comparison.critical_a;
+    const auto& b = comparison.critical_b;
+    out << "Critical path composition:\n";
+    for (auto [label, value_a, value_b] : {std::make_tuple("run", a.run, b.run),
+                                           std::make_tuple("network", a.network, b.network),
+                                           std::make_tuple("wait", a.wait, b.wait),
+                                           std::make_tuple("sleep", a.sleep, b.sleep)}) {
+        out << "  " << std::left << std::setw(9) << (std::string(label) + ":") << std::right
+            << value_a << " -> " << value_b << " (" << signed_value(value_b - value_a) << ")\n";
+    }
+
+    auto list = [&out](const char* title, size_t count, const std::vector<std::string>& examples) {
+        out << "  " << title << " critical path: " << count;
+        for (size_t i = 0; i < examples.size(); ++i) {
+            out << (i == 0 ? " (" : ", ") << examples[i];
+        }
+        if (!examples.empty()) {
+            out << (count > examples.size() ? ", ...)" : ")");
+        }
+        out << "\n";
+    };
+    list("Joined", comparison.joined_critical_path, comparison.joined_critical_examples);
+    list("Left", comparison.left_critical_path, comparison.left_critical_examples);
+
+    std::string text = out.str();
+    text.pop_back();
+    return text;
+}
+
+} // namespace simulator
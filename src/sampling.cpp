@@ -0,0 +1,191 @@
+#include "../include/sampling.hpp"
+#include "../include/simulator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace simulator {
+
+namespace {
+
+// Two-sided 95% Student t quantiles for 1..30 degrees of freedom; the
+// normal quantile beyond
+double t_quantile_95(size_t degrees_of_freedom) {
+    static const double kTable[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (degrees_of_freedom == 0) return 0.0;
+    if (degrees_of_freedom <= std::size(kTable)) return kTable[degrees_of_freedom - 1];
+    return 1.960;
+}
+
+double sample_stddev(const std::vector<double>& values, double mean) {
+    if (values.size() < 2) return 0.0;
+    double squares = 0.0;
+    for (double value : values) {
+        squares += (value - mean) * (value - mean);
+    }
+    return std::sqrt(squares / static_cast<double>(values.size() - 1));
+}
+
+// Steady-state measurements of one detailed window
+struct WindowStats {
+    bool measured = false;     // More tasks than the warm-up at both ends
+    size_t tasks = 0;
+    int64_t ramp = 0;          // Until the first warm-up tasks had finished
+    int64_t drain = 0;         // From the steady part to the last finish
+    double task_time = 0.0;    // Time per finished task in the steady part
+    double utilization = 0.0;  // Percent busy core time in the steady part
+};
+
+WindowStats simulate_window(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+                            const std::unordered_map<std::string, size_t>& index_of,
+                            size_t first, size_t last, size_t warmup) {
+    WindowStats stats;
+    stats.tasks = last - first;
+    if (stats.tasks <= 2 * warmup) return stats;
+
+    // The slice, with dependencies on earlier slices already satisfied
+    std::vector<models::Task> slice;
+    slice.reserve(stats.tasks);
+    for (size_t i = first; i < last; ++i) {
+        auto task = tasks[i];
+        task.index = i - first;
+        task.dependency_indices.clear();
+        std::erase_if(task.dependencies, [&](const std::string& name) {
+            return index_of.at(name) < first;
+        });
+        slice.push_back(std::move(task));
+    }
+
+    TaskSimulator sim(config, std::move(slice));
+    sim.run();
+
+    std::vector<int64_t> finishes;
+    finishes.reserve(stats.tasks);
+    for (const auto& record : sim.records()) {
+        finishes.push_back(record.finish);
+    }
+    std::sort(finishes.begin(), finishes.end());
+    // Steady part: between the first and the last `warmup` finishes, while
+    // the slice neither fills nor drains the hosts
+    int64_t from = warmup > 0 ? finishes[warmup - 1] : 0;
+    int64_t to = finishes[stats.tasks - warmup - 1];
+    stats.measured = true;
+    stats.ramp = from;
+    stats.drain = finishes.back() - to;
+    stats.task_time = static_cast<double>(to - from) / static_cast<double>(stats.tasks - 2 * warmup);
+
+    // Core time spent inside [from, to] against the cores available
+    if (to > from) {
+        int64_t busy = 0;
+        for (const auto& record : sim.records()) {
+            busy += std::max<int64_t>(0, std::min(record.finish, to) - std::max(record.start, from));
+        }
+        int64_t cores = 0;
+        for (const auto& host : sim.hosts()) {
+            cores += host->cpu_cores;
+        }
+        stats.utilization = 100.0 * static_cast<double>(busy) / static_cast<double>(cores * (to - from));
+    }
+    return stats;
+}
+
+} // namespace
+
+void SamplingConfig::validate() const {
+    if (window == 0 || period < window) {
+        throw std::invalid_argument("Sampling needs 0 < window <= period, got window " + std::to_string(window) +
+                                    " and period " + std::to_string(period));
+    }
+    if (2 * warmup >= window) {
+        throw std::invalid_argument("Sampling warm-up must be shorter than half the window, got " +
+                                    std::to_string(warmup));
+    }
+}
+
+SampledRun run_sampled(const models::ExperimentConfig& config, const std::vector<models::Task>& tasks,
+                       const SamplingConfig& sampling, WorkStealingPool& pool) {
+    sampling.validate();
+    if (config.autoscaling.enabled) {
+        throw std::invalid_argument("Sampling does not support autoscaling");
+    }
+
+    std::unordered_map<std::string, size_t> index_of;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        index_of[tasks[i].name] = i;
+    }
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        for (const auto& dep_name : tasks[i].dependencies) {
+            auto it = index_of.find(dep_name);
+            if (it == index_of.end() || it->second >= i) {
+                throw std::invalid_argument("Sampling needs dependencies on earlier tasks, but task '" +
+                                            tasks[i].name + "' depends on '" + dep_name + "'");
+            }
+        }
+    }
+
+    size_t num_periods = (tasks.size() + sampling.period - 1) / sampling.period;
+    auto windows = pool.map<WindowStats>(num_periods, [&](size_t p) {
+        size_t first = p * sampling.period;
+        size_t last = std::min(tasks.size(), first + sampling.window);
+        return simulate_window(config, tasks, index_of, first, last, sampling.warmup);
+    });
+
+    SampledRun run;
+    run.tasks = tasks.size();
+    std::vector<double> task_times;
+    for (const auto& window : windows) {
+        if (!window.measured) continue;
+        ++run.windows;
+        run.detailed_tasks += window.tasks;
+        task_times.push_back(window.task_time);
+        run.window_task_time.push_back(window.task_time);
+        run.window_utilization.push_back(window.utilization);
+    }
+    if (run.windows == 0) {
+        throw std::invalid_argument("Sampling needs at least one window with more than " +
+                                    std::to_string(2 * sampling.warmup) + " tasks");
+    }
+
+    double mean_task_time = 0.0;
+    for (double task_time : task_times) mean_task_time += task_time;
+    mean_task_time /= static_cast<double>(task_times.size());
+
+    // Fast-forward: every period advances by its tasks at its window's
+    // rate; a period too short to measure uses the mean rate. The run
+    // fills the hosts like the first window and drains like the last
+    // measured one, so those warm-up tasks are timed by ramp and drain.
+    const auto& last = *std::find_if(windows.rbegin(), windows.rend(),
+                                     [](const WindowStats& window) { return window.measured; });
+    double makespan = static_cast<double>(windows.front().ramp + last.drain);
+    double weight_squares = 0.0;
+    size_t fast_forwarded = tasks.size() - 2 * sampling.warmup;
+    for (size_t p = 0; p < num_periods; ++p) {
+        size_t period_tasks = std::min(tasks.size(), (p + 1) * sampling.period) - p * sampling.period;
+        period_tasks = std::min(period_tasks, fast_forwarded);
+        fast_forwarded -= period_tasks;
+        double n = static_cast<double>(period_tasks);
+        makespan += n * (windows[p].measured ? windows[p].task_time : mean_task_time);
+        weight_squares += n * n;
+    }
+
+    // Per-window task times as independent samples of the steady state
+    double t = t_quantile_95(run.windows - 1);
+    double makespan_half = t * sample_stddev(task_times, mean_task_time) * std::sqrt(weight_squares);
+    run.makespan = Interval{makespan, std::max(0.0, makespan - makespan_half), makespan + makespan_half};
+
+    double mean_utilization = 0.0;
+    for (double utilization : run.window_utilization) mean_utilization += utilization;
+    mean_utilization /= static_cast<double>(run.windows);
+    double utilization_half = t * sample_stddev(run.window_utilization, mean_utilization) /
+                              std::sqrt(static_cast<double>(run.windows));
+    run.utilization = Interval{mean_utilization, std::max(0.0, mean_utilization - utilization_half),
+                               std::min(100.0, mean_utilization + utilization_half)};
+    return run;
+}
+
+} // namespace simulator
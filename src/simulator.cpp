@@ -3,144 +3,1021 @@
 #include <iostream>
 #include <stdexcept>
 #include <sstream>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <random>
 
 namespace simulator {
 
+// run_time scaled by the speed for the task's class, kept integral so
+// schedules stay reproducible
+static int scaled_run_time(const models::Task& task, double speed,
+                           const std::unordered_map<std::string, double>& class_speeds) {
+    if (!task.scaling_class.empty()) {
+        auto it = class_speeds.find(task.scaling_class);
+        if (it != class_speeds.end()) {
+            speed = it->second;
+        }
+    }
+    return static_cast<int>(std::llround(task.run_time / speed));
+}
+
 // Host implementation
 Host::Host(simcpp20::simulation<>& sim, const std::string& name,
-           int cpu_cores, int ram_capacity)
+           int cpu_cores, int ram_capacity, double speed,
+           std::unordered_map<std::string, double> class_speeds)
     : name(name),
       cpu(sim, cpu_cores),
       ram(sim, ram_capacity, ram_capacity), // container(sim, capacity, init_level)
       cpu_cores(cpu_cores),
-      ram_capacity(ram_capacity) {
+      ram_capacity(ram_capacity),
+      speed(speed),
+      class_speeds(std::move(class_speeds)) {
+
+    logger::info("Host {} initialized: {} CPU cores, {} RAM units, speed {}", name, cpu_cores, ram_capacity, speed);
+}
 
-    logger::info("Host {} initialized: {} CPU cores, {} RAM units", name, cpu_cores, ram_capacity);
+int Host::execution_time(const models::Task& task) const {
+    return scaled_run_time(task, speed, class_speeds);
 }
 
 // NetworkLink implementation
-NetworkLink::NetworkLink(simcpp20::simulation<>& sim, size_t num_hosts) {
-    // Create full-duplex links between all pairs of hosts
-    for (size_t from_idx = 0; from_idx < num_hosts; ++from_idx) {
-        for (size_t to_idx = 0; to_idx < num_hosts; ++to_idx) {
-            if (from_idx != to_idx) {
-                auto key = std::make_pair(from_idx, to_idx);
-                links_[key] = std::make_unique<simcpp20::resource<>>(sim, 1);
+NetworkLink::NetworkLink(simcpp20::simulation<>& sim, size_t num_hosts, models::LinkModel model)
+    : sim_(sim), num_hosts_(num_hosts), model_(model) {
+    logger::info("Network initialized for {} hosts (directional links created on first use{})", num_hosts,
+                 model == models::LinkModel::Clock ? ", link clocks" : "");
+}
+
+static void check_link(size_t from_host_index, size_t to_host_index, size_t num_hosts) {
+    if (from_host_index >= num_hosts || to_host_index >= num_hosts || from_host_index == to_host_index) {
+        throw std::runtime_error("No network link from host " + std::to_string(from_host_index) +
+                               " to host " + std::to_string(to_host_index));
+    }
+}
+
+simcpp20::resource<>* NetworkLink::get_link(size_t from_host_index, size_t to_host_index) {
+    check_link(from_host_index, to_host_index, num_hosts_);
+
+    auto& link = links_[std::make_pair(from_host_index, to_host_index)];
+    if (!link) {
+        link = std::make_unique<simcpp20::resource<>>(sim_, 1);
+    }
+    return link.get();
+}
+
+NetworkLink::Transfer NetworkLink::transfer(size_t from_host_index, size_t to_host_index, int64_t duration) {
+    check_link(from_host_index, to_host_index, num_hosts_);
+    return Transfer{*this, clocks_[static_cast<uint64_t>(from_host_index) << 32 | to_host_index], duration};
+}
+
+bool NetworkLink::busy(size_t from_host_index, size_t to_host_index) const {
+    auto it = clocks_.find(static_cast<uint64_t>(from_host_index) << 32 | to_host_index);
+    return it != clocks_.end() && it->second.busy;
+}
+
+void NetworkLink::Transfer::await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    if (!clock_.busy) {
+        clock_.busy = true;
+        begin();
+        return;
+    }
+    if (clock_.tail) {
+        clock_.tail->next_ = this;
+    } else {
+        clock_.head = this;
+    }
+    clock_.tail = this;
+}
+
+void NetworkLink::Transfer::begin() {
+    start_ = static_cast<int64_t>(network_.sim_.now());
+    auto done = network_.sim_.timeout(duration_);
+    done.add_callback([this](const simcpp20::event<>&) {
+        // The frame holding this node may end once the handle resumes
+        auto& clock = clock_;
+        auto handle = handle_;
+        if (Transfer* next = clock.head) {
+            // The next transfer starts through one event at the release,
+            // the slot its triggered request event would take
+            clock.head = next->next_;
+            if (!clock.head) clock.tail = nullptr;
+            auto granted = next->network_.sim_.event();
+            granted.add_callback([next](const simcpp20::event<>&) { next->begin(); });
+            granted.trigger();
+        } else {
+            clock.busy = false;
+        }
+        handle.resume();
+    });
+}
+
+void NetworkLink::set_scale(size_t from_host_index, size_t to_host_index, double scale) {
+    if (scale == 1.0) {
+        scales_.erase(std::make_pair(from_host_index, to_host_index));
+    } else {
+        scales_[std::make_pair(from_host_index, to_host_index)] = scale;
+    }
+}
+
+int64_t NetworkLink::transfer_time(size_t from_host_index, size_t to_host_index, int64_t network_time) const {
+    if (scales_.empty()) return network_time;
+    auto it = scales_.find(std::make_pair(from_host_index, to_host_index));
+    return it == scales_.end() ? network_time : std::llround(static_cast<double>(network_time) * it->second);
+}
+
+// DrfAdmission implementation
+simcpp20::event<> DrfAdmission::admit(size_t group, int ram) {
+    auto admitted = sim_.event();
+    auto& state = groups_[group];
+    if (state.waiting.empty()) {
+        order_.emplace(share(state), group);
+    }
+    state.waiting.push(Waiter{ram, admitted});
+    dispatch();
+    return admitted;
+}
+
+void DrfAdmission::release(size_t group, int ram) {
+    auto& state = groups_[group];
+    bool queued = !state.waiting.empty();
+    if (queued) order_.erase({share(state), group});
+    state.cores -= 1;
+    state.ram -= ram;
+    if (queued) order_.emplace(share(state), group);
+
+    host_.cpu.release();
+    host_.ram.put(ram);
+    dispatch();
+}
+
+double DrfAdmission::share(const GroupState& group) const {
+    return std::max(static_cast<double>(group.cores) / host_.cpu_cores,
+                    static_cast<double>(group.ram) / host_.ram_capacity);
+}
+
+void DrfAdmission::dispatch() {
+    while (!order_.empty()) {
+        size_t group = order_.begin()->second;
+        auto& state = groups_[group];
+        auto& head = state.waiting.front();
+        if (host_.cpu.available() == 0 || host_.ram.level() < static_cast<uint64_t>(head.ram)) {
+            break;
+        }
+
+        // Both have room, so both are granted immediately
+        host_.ram.get(head.ram);
+        host_.cpu.try_acquire();
+        head.admitted.trigger();
+
+        order_.erase(order_.begin());
+        state.cores += 1;
+        state.ram += head.ram;
+        state.waiting.pop();
+        if (!state.waiting.empty()) {
+            order_.emplace(share(state), group);
+        }
+    }
+}
+
+// Autoscaler implementation
+Autoscaler::Autoscaler(simcpp20::simulation<>& sim, const models::AutoscalingConfig& config,
+                       std::vector<models::Task>& tasks, std::vector<HostPtr>& hosts,
+                       NetworkLink& network, const EngineCounters& counters)
+    : sim_(sim),
+      config_(config),
+      tasks_(tasks),
+      hosts_(hosts),
+      network_(network),
+      counters_(counters),
+      first_index_(hosts.size()),
+      last_action_(-config.cooldown) {
+    for (size_t i = 0; i < config.initial_hosts; ++i) {
+        add_host(true);
+    }
+}
+
+std::optional<simcpp20::event<>> Autoscaler::place(size_t task_index) {
+    if (!waiting_.empty() || !place_now(task_index)) {
+        auto placed = sim_.event();
+        waiting_.emplace_back(task_index, placed);
+        return placed;
+    }
+    return std::nullopt;
+}
+
+bool Autoscaler::place_now(size_t task_index) {
+    // Usable host with a core not yet promised to a placed task; all pool
+    // hosts have the same cores, so the fewest placed tasks wins
+    size_t best = SIZE_MAX;
+    for (size_t slot = 0; slot < slots_.size(); ++slot) {
+        const auto& state = slots_[slot];
+        if (state.state == SlotState::Active &&
+            state.load < static_cast<size_t>(config_.host.cpu_cores) &&
+            (best == SIZE_MAX || state.load < slots_[best].load)) {
+            best = slot;
+        }
+    }
+    if (best == SIZE_MAX) return false;
+
+    auto& task = tasks_[task_index];
+    task.host_index = first_index_ + best;
+    task.host = hosts_[task.host_index]->name;
+    ++slots_[best].load;
+    return true;
+}
+
+void Autoscaler::dispatch() {
+    while (!waiting_.empty() && place_now(waiting_.front().first)) {
+        waiting_.front().second.trigger();
+        waiting_.pop_front();
+    }
+}
+
+void Autoscaler::release(size_t task_index) {
+    size_t slot = tasks_[task_index].host_index - first_index_;
+    if (--slots_[slot].load == 0 && slots_[slot].state == SlotState::Draining) {
+        remove(slot);
+    }
+    dispatch();
+}
+
+void Autoscaler::add_host(bool immediately) {
+    // Reuse the lowest slot of a removed host, else append one
+    size_t slot = 0;
+    while (slot < slots_.size() && slots_[slot].state != SlotState::Removed) ++slot;
+    if (slot == slots_.size()) {
+        slots_.emplace_back();
+        hosts_.push_back(nullptr);
+        network_.add_host();
+    }
+
+    const auto& host = config_.host;
+    hosts_[first_index_ + slot] = std::make_shared<Host>(
+        sim_, slot_name(slot), host.cpu_cores, host.ram, host.speed, host.class_speeds);
+    slots_[slot].state = SlotState::Provisioning;
+    slots_[slot].since = static_cast<int64_t>(sim_.now());
+    peak_hosts_ = std::max(peak_hosts_, live_hosts());
+
+    if (immediately || config_.provisioning_delay == 0) {
+        activate(slot);
+    } else {
+        sim_.timeout(config_.provisioning_delay).add_callback([this, slot](const auto&) { activate(slot); });
+    }
+}
+
+void Autoscaler::activate(size_t slot) {
+    slots_[slot].state = SlotState::Active;
+    logger::info("[AUTOSCALER]\t[t={}]\tHost {} ready", static_cast<int>(sim_.now()), slot_name(slot));
+
+    dispatch();
+}
+
+void Autoscaler::remove(size_t slot) {
+    auto& state = slots_[slot];
+    state.host_time += static_cast<int64_t>(sim_.now()) - state.since;
+    state.state = SlotState::Removed;
+    logger::info("[AUTOSCALER]\t[t={}]\tHost {} removed", static_cast<int>(sim_.now()), slot_name(slot));
+}
+
+size_t Autoscaler::live_hosts() const {
+    return static_cast<size_t>(std::count_if(slots_.begin(), slots_.end(), [](const Slot& slot) {
+        return slot.state == SlotState::Provisioning || slot.state == SlotState::Active;
+    }));
+}
+
+bool Autoscaler::finished() const {
+    return counters_.tasks_completed.load(std::memory_order_relaxed) >= tasks_.size();
+}
+
+void Autoscaler::evaluate() {
+    int64_t now = static_cast<int64_t>(sim_.now());
+    if (now - last_action_ < config_.cooldown) return;
+
+    // Queue: tasks without a host plus placed tasks not running yet
+    int64_t cores = 0;
+    int64_t busy = 0;
+    int64_t queued = static_cast<int64_t>(waiting_.size());
+    for (size_t slot = 0; slot < slots_.size(); ++slot) {
+        const auto& state = slots_[slot];
+        if (state.state != SlotState::Active && state.state != SlotState::Draining) continue;
+        const auto& host = *hosts_[first_index_ + slot];
+        int64_t running = host.cpu_cores - static_cast<int64_t>(host.cpu.available());
+        queued += static_cast<int64_t>(state.load) - running;
+        if (state.state == SlotState::Active) {
+            cores += host.cpu_cores;
+            busy += running;
+        }
+    }
+    double utilization = cores > 0 ? static_cast<double>(busy) / static_cast<double>(cores)
+                                   : (queued > 0 ? 1.0 : 0.0);
+
+    size_t live = live_hosts();
+    bool up = (config_.scale_up_queue > 0.0 &&
+               static_cast<double>(queued) >= config_.scale_up_queue * static_cast<double>(std::max<size_t>(live, 1))) ||
+              (config_.scale_up_utilization > 0.0 && utilization >= config_.scale_up_utilization);
+    if (live < config_.min_hosts || (live == 0 && queued > 0) || (up && live < config_.max_hosts)) {
+        add_host(false);
+        ++scale_ups_;
+        last_action_ = now;
+        logger::info("[AUTOSCALER]\t[t={}]\tScaling up to {} hosts ({} queued, {:.0f}% cores busy)",
+                     static_cast<int>(now), live + 1, queued, utilization * 100.0);
+        return;
+    }
+
+    if (live > config_.min_hosts && queued == 0 && utilization <= config_.scale_down_utilization) {
+        // Drain the least loaded host, the newest among equals
+        size_t drain = SIZE_MAX;
+        for (size_t slot = 0; slot < slots_.size(); ++slot) {
+            if (slots_[slot].state == SlotState::Active &&
+                (drain == SIZE_MAX || slots_[slot].load <= slots_[drain].load)) {
+                drain = slot;
             }
         }
+        if (drain == SIZE_MAX) return;
+
+        slots_[drain].state = SlotState::Draining;
+        ++scale_downs_;
+        last_action_ = now;
+        logger::info("[AUTOSCALER]\t[t={}]\tDraining {} ({:.0f}% cores busy)",
+                     static_cast<int>(now), slot_name(drain), utilization * 100.0);
+        if (slots_[drain].load == 0) {
+            remove(drain);
+        }
     }
+}
 
-    logger::info("Network initialized with {} directional links for {} hosts", links_.size(), num_hosts);
+simcpp20::process<> autoscaler_process(simcpp20::simulation<>& sim, Autoscaler& autoscaler) {
+    while (!autoscaler.finished()) {
+        co_await sim.timeout(autoscaler.interval());
+        if (!autoscaler.finished()) {
+            autoscaler.evaluate();
+        }
+    }
 }
 
-simcpp20::resource<>* NetworkLink::get_link(size_t from_host_index, size_t to_host_index) {
-    auto key = std::make_pair(from_host_index, to_host_index);
-    auto it = links_.find(key);
+int64_t Autoscaler::host_time(size_t host_index, int64_t end) const {
+    if (host_index < first_index_ || host_index >= first_index_ + slots_.size()) {
+        return end;
+    }
+    const auto& slot = slots_[host_index - first_index_];
+    int64_t time = slot.host_time;
+    if (slot.state != SlotState::Removed) {
+        time += std::max<int64_t>(0, end - slot.since);
+    }
+    return time;
+}
 
-    if (it == links_.end()) {
-        throw std::runtime_error("No network link from host " + std::to_string(from_host_index) +
-                               " to host " + std::to_string(to_host_index));
+int64_t Autoscaler::pool_host_time(int64_t end) const {
+    int64_t total = 0;
+    for (size_t slot = 0; slot < slots_.size(); ++slot) {
+        total += host_time(first_index_ + slot, end);
     }
+    return total;
+}
+
+// QuantumClock implementation
+QuantumClock::QuantumClock(simcpp20::simulation<>& sim, int64_t quantum, size_t num_tasks, size_t num_hosts)
+    : task_finish(num_tasks, 0),
+      cpu_release(num_hosts, 0),
+      ram_release(num_hosts, 0),
+      sim_(sim),
+      quantum_(quantum) {
+    if (quantum <= 0) {
+        throw std::invalid_argument("Time quantum must be > 0, got " + std::to_string(quantum));
+    }
+}
+
+simcpp20::event<> QuantumClock::wait_until(int64_t exact_time) {
+    // All waits end on multiples of the quantum, so now() is one as well
+    int64_t now = static_cast<int64_t>(sim_.now());
+    int64_t at = std::max(now, (exact_time + quantum_ / 2) / quantum_ * quantum_);
+
+    auto it = pending_.find(at);
+    if (it != pending_.end()) {
+        return it->second;
+    }
+
+    auto tick = sim_.timeout(at - now);
+    ++ticks_created_;
+    pending_.emplace(at, tick);
+    tick.add_callback([this, at](const auto&) { pending_.erase(at); });
+    return tick;
+}
+
+const char* to_string(TaskPhase phase) {
+    switch (phase) {
+        case TaskPhase::Created: return "created";
+        case TaskPhase::Sleeping: return "sleeping";
+        case TaskPhase::WaitingDependency: return "waiting for dependency";
+        case TaskPhase::WaitingLink: return "waiting for link";
+        case TaskPhase::Transferring: return "transferring";
+        case TaskPhase::WaitingRam: return "waiting for RAM";
+        case TaskPhase::WaitingCpu: return "waiting for CPU";
+        case TaskPhase::WaitingAdmission: return "waiting for admission";
+        case TaskPhase::WaitingPlacement: return "waiting for a pool host";
+        case TaskPhase::Running: return "running";
+        case TaskPhase::WaitingStream: return "waiting for streamed input";
+        case TaskPhase::Done: return "done";
+    }
+    return "unknown";
+}
+
+// State dump requests (set from signal handlers, consumed by the run loop)
+static std::atomic<bool> state_dump_requested{false};
+static_assert(std::atomic<bool>::is_always_lock_free, "state dump flag must be signal-safe");
+
+void request_state_dump() {
+    state_dump_requested.store(true, std::memory_order_relaxed);
+}
+
+static void state_dump_signal_handler(int) {
+    request_state_dump();
+}
+
+void install_state_dump_handler() {
+    std::signal(SIGUSR1, state_dump_signal_handler);
+}
+
+uint64_t trace_digest(const std::vector<models::Task>& tasks,
+                      const std::vector<TaskRecord>& records) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (size_t i = 0; i < tasks.size() && i < records.size(); ++i) {
+        mix(tasks[i].name.data(), tasks[i].name.size());
+        mix(&records[i].start, sizeof(records[i].start));
+        mix(&records[i].finish, sizeof(records[i].finish));
+    }
+    return hash;
+}
+
+// Time `producer` emits chunk `chunk` of `chunks`: evenly over its run
+static int64_t chunk_emitted(const SimulationContext& ctx, size_t producer, int64_t chunk, int64_t chunks) {
+    int64_t exec_time = ctx.stragglers ? ctx.stragglers->exec_time[producer] : ctx.tasks[producer].exec_time;
+    return ctx.records[producer].start + chunk * exec_time / chunks;
+}
+
+// Transfer time of chunks (from, to] of an output taking `network_time` in full
+static int64_t chunk_transfer(int64_t network_time, int64_t from, int64_t to, int64_t chunks) {
+    return to * network_time / chunks - from * network_time / chunks;
+}
+
+// Chunks 2..chunks of a pipelined cross-host dependency. Each link hold
+// sends every chunk emitted by the time the link was acquired, so a backlog
+// costs one request and one timeout however many chunks it holds. The last
+// chunk leaves when the producer finishes.
+static simcpp20::process<> chunk_stream(
+    simcpp20::simulation<>& sim,
+    SimulationContext& ctx,
+    size_t producer,
+    size_t consumer,
+    int64_t chunks) {
+
+    const auto& dep_task = ctx.tasks[producer];
+    const auto& task = ctx.tasks[consumer];
+    auto* link = ctx.network->get_link(dep_task.host_index, task.host_index);
+    uint32_t link_series = ctx.recorder ? ctx.recorder->link_series(dep_task.host_index, task.host_index) : 0;
+    auto record = [&](uint32_t series, int64_t delta) {
+        if (ctx.recorder) {
+            ctx.recorder->add(series, static_cast<int64_t>(sim.now()), delta);
+        }
+    };
+    int64_t network_time = ctx.network->transfer_time(dep_task.host_index, task.host_index, dep_task.network_time);
+    int64_t start = ctx.records[producer].start;
+    int64_t exec_time = chunk_emitted(ctx, producer, chunks, chunks) - start;
+
+    for (int64_t sent = 1; sent < chunks;) {
+        if (sent + 1 == chunks) {
+            co_await ctx.task_completed[producer];
+        } else {
+            int64_t emitted = chunk_emitted(ctx, producer, sent + 1, chunks);
+            if (emitted > static_cast<int64_t>(sim.now())) {
+                co_await sim.timeout(emitted - static_cast<int64_t>(sim.now()));
+            }
+        }
 
-    return it->second.get();
+        record(link_series + 1, 1);
+        auto net_req = link->request();
+        co_await net_req;
+        record(link_series + 1, -1);
+        record(link_series, 1);
+
+        // Chunk k is out once start + k * exec_time / chunks (rounded down)
+        // has passed; the last one only with the producer's completion
+        int64_t elapsed = static_cast<int64_t>(sim.now()) - start;
+        int64_t ready = exec_time > 0 ? ((elapsed + 1) * chunks - 1) / exec_time : chunks;
+        if (!ctx.task_completed[producer].processed()) {
+            ready = std::min(ready, chunks - 1);
+        }
+        ready = std::clamp(ready, sent + 1, chunks);
+
+        co_await sim.timeout(chunk_transfer(network_time, sent, ready, chunks));
+        link->release();
+        record(link_series, -1);
+        sent = ready;
+    }
 }
 
 // Task process coroutine
 simcpp20::process<> task_process(
     simcpp20::simulation<>& sim,
-    const models::Task& task,
-    size_t task_index,
-    const std::vector<HostPtr>& hosts,
-    NetworkLinkPtr network,
-    std::vector<simcpp20::event<>>& task_completed,
-    const std::vector<models::Task>& tasks) {
+    SimulationContext& ctx,
+    size_t task_index) {
+
+    const auto& tasks = ctx.tasks;
+    const auto& task = tasks[task_index];
+    auto& task_completed = ctx.task_completed;
+    auto& records = ctx.records;
+    auto enter = [&](TaskPhase phase, size_t peer = SIZE_MAX) {
+        auto& current = records[task_index];
+        int64_t spent = static_cast<int64_t>(sim.now()) - current.phase_since;
+        switch (current.phase) {
+            case TaskPhase::WaitingDependency: current.dependency_wait += spent; break;
+            case TaskPhase::WaitingLink: current.link_wait += spent; break;
+            case TaskPhase::Transferring: current.transfer += spent; break;
+            case TaskPhase::WaitingRam: current.ram_wait += spent; break;
+            case TaskPhase::WaitingCpu:
+            case TaskPhase::WaitingAdmission:
+            case TaskPhase::WaitingPlacement: current.cpu_wait += spent; break;
+            default: break;
+        }
+        current.phase = phase;
+        current.phase_since = static_cast<int64_t>(sim.now());
+        current.peer = peer;
+    };
+    // Approximate mode: exact time of this process and hand-overs from the
+    // event that unblocked it
+    auto* quantum = ctx.quantum;
+    int64_t exact = 0;
+    auto wait_for = [&](int64_t delay) {
+        if (!quantum) return sim.timeout(delay);
+        exact += delay;
+        return quantum->wait_until(exact);
+    };
+    auto hand_over = [&](bool blocked, int64_t released) {
+        if (blocked) exact = std::max(exact, released);
+    };
+    auto record = [&](uint32_t series, int64_t delta) {
+        if (ctx.recorder) {
+            ctx.recorder->add(series, static_cast<int64_t>(sim.now()), delta);
+        }
+    };
 
     // Step 1: Initial sleep
     if (task.initial_sleep_time > 0) {
         logger::debug("[{}]\t[t={}]\tTask {}: Sleeping for {} time units",
                      task.host, static_cast<int>(sim.now()), task.name, task.initial_sleep_time);
-        co_await sim.timeout(task.initial_sleep_time);
+        enter(TaskPhase::Sleeping);
+        co_await wait_for(task.initial_sleep_time);
     }
 
-    // Step 2: Wait for dependencies if exist
+    // Pool tasks get a host once their dependencies are done, so the
+    // transfers below go to the host they run on
+    bool pooled = task.host_index == SIZE_MAX;
+    if (pooled) {
+        for (size_t dep_index : task.dependency_indices) {
+            enter(TaskPhase::WaitingDependency, dep_index);
+            if (task.pipelined()) {
+                co_await ctx.task_started->at(dep_index);
+            } else {
+                co_await task_completed[dep_index];
+            }
+        }
+        if (auto placed = ctx.autoscaler->place(task_index)) {
+            logger::debug("[{}]\t[t={}]\tTask {}: Waiting for a pool host",
+                         task.host, static_cast<int>(sim.now()), task.name);
+            enter(TaskPhase::WaitingPlacement);
+            co_await *placed;
+        }
+    }
+
+    // Step 2: Wait for dependencies if exist. A pipelined task goes on after
+    // the first chunk of each input and collects the rest while it runs
+    std::vector<simcpp20::event<>> streams;
     for (size_t dep_index : task.dependency_indices) {
         const auto& dep_task = tasks[dep_index];
 
         logger::debug("[{}]\t[t={}]\tTask {}: Waiting for dependency {}",
                      task.host, static_cast<int>(sim.now()), task.name, dep_task.name);
 
-        co_await task_completed[dep_index];
+        enter(TaskPhase::WaitingDependency, dep_index);
+        if (task.pipelined()) {
+            // Released by the first chunk of the producer's output
+            co_await ctx.task_started->at(dep_index);
+            int64_t first = chunk_emitted(ctx, dep_index, 1, task.pipeline_chunks);
+            if (first > static_cast<int64_t>(sim.now())) {
+                co_await sim.timeout(first - static_cast<int64_t>(sim.now()));
+            }
+        } else {
+            co_await task_completed[dep_index];
+            if (quantum) hand_over(true, quantum->task_finish[dep_index]);
+        }
+        bool streamed = false;
 
         // If cross-host dependency, wait for network transmission
         if (dep_task.host_index != task.host_index) {
             if (dep_task.network_time > 0) {
-                auto* link = network->get_link(dep_task.host_index, task.host_index);
+                int64_t network_time = ctx.network->transfer_time(dep_task.host_index, task.host_index,
+                                                                  dep_task.network_time);
 
                 logger::debug("[{}]\t[t={}]\tTask {}: Waiting for network transmission from {} ({} time units)",
                              task.host, static_cast<int>(sim.now()), task.name,
-                             dep_task.name, dep_task.network_time);
+                             dep_task.name, network_time);
+
+                if (ctx.network->model() == models::LinkModel::Clock) {
+                    // A free link is taken without a request event; a
+                    // queued transfer is started by the one before it
+                    bool link_blocked = ctx.network->busy(dep_task.host_index, task.host_index);
+                    enter(link_blocked ? TaskPhase::WaitingLink : TaskPhase::Transferring, dep_index);
+                    logger::debug("[NETWORK]\t[t={}]\tTransmission queued: {} -> {}",
+                                 static_cast<int>(sim.now()), dep_task.host, task.host);
+                    int64_t start = co_await ctx.network->transfer(dep_task.host_index, task.host_index,
+                                                                   network_time);
+                    if (ctx.grants) {
+                        ctx.grants->push_back(GrantStep{static_cast<uint32_t>(task_index),
+                                                        static_cast<uint32_t>(dep_index), network_time});
+                    }
+                    if (link_blocked) {
+                        auto& current = records[task_index];
+                        current.link_wait += start - current.phase_since;
+                        current.phase = TaskPhase::Transferring;
+                        current.phase_since = start;
+                    }
+
+                    logger::debug("[NETWORK]\t[t={}]\tTransmission completed: {} -> {}",
+                                 static_cast<int>(sim.now()), dep_task.host, task.host);
+                    continue;  // Link clocks exclude pipelined tasks, so no stream follows
+                }
+
+                auto* link = ctx.network->get_link(dep_task.host_index, task.host_index);
+                uint32_t link_series = ctx.recorder
+                    ? ctx.recorder->link_series(dep_task.host_index, task.host_index) : 0;
 
+                enter(TaskPhase::WaitingLink, dep_index);
+                record(link_series + 1, 1);
+                bool link_blocked = link->available() == 0;
                 auto net_req = link->request();
                 co_await net_req;
+                if (quantum) hand_over(link_blocked, quantum->link_release[link]);
+                if (ctx.grants) {
+                    ctx.grants->push_back(GrantStep{static_cast<uint32_t>(task_index),
+                                                    static_cast<uint32_t>(dep_index), network_time});
+                }
+                record(link_series + 1, -1);
+                record(link_series, 1);
+                enter(TaskPhase::Transferring, dep_index);
 
                 logger::debug("[NETWORK]\t[t={}]\tTransmission started: {} -> {} ({} time units)",
-                             static_cast<int>(sim.now()), dep_task.host, task.host, dep_task.network_time);
+                             static_cast<int>(sim.now()), dep_task.host, task.host, network_time);
 
-                co_await sim.timeout(dep_task.network_time);
+                int64_t transfer_time = task.pipelined()
+                    ? chunk_transfer(network_time, 0, 1, task.pipeline_chunks)
+                    : network_time;
+                co_await wait_for(transfer_time);
 
                 logger::debug("[NETWORK]\t[t={}]\tTransmission completed: {} -> {}",
                              static_cast<int>(sim.now()), dep_task.host, task.host);
 
+                if (quantum) quantum->link_release[link] = exact;
                 link->release();
+                record(link_series, -1);
+
+                if (task.pipelined()) {
+                    streams.push_back(chunk_stream(sim, ctx, dep_index, task_index, task.pipeline_chunks));
+                    streamed = true;
+                }
             }
         }
+        // Without a transfer the last chunk is there when the producer finishes
+        if (task.pipelined() && !streamed) {
+            streams.push_back(task_completed[dep_index]);
+        }
     }
 
     // Step 3: Task is now ready
+    records[task_index].ready = static_cast<int64_t>(sim.now());
     logger::debug("[{}]\t[t={}]\tTask {}: Ready to execute",
                  task.host, static_cast<int>(sim.now()), task.name);
 
     // Step 4: Acquire resources (RAM and CPU)
-    auto host = hosts[task.host_index];
+    auto host = ctx.hosts[task.host_index];
+    auto& host_counters = ctx.counters.hosts[task.host_index];
+    simcpp20::semaphore<>::hold core;  // Without DRF admission, which holds the cores it grants
 
-    // Wait for available RAM (task will block until enough RAM is available)
-    logger::debug("[{}]\t[t={}]\tTask {}: Waiting for {} RAM units",
-                 task.host, static_cast<int>(sim.now()), task.name, task.ram);
+    if (ctx.admission) {
+        // DRF admission grants RAM and a core together, fairest group first
+        logger::debug("[{}]\t[t={}]\tTask {}: Waiting for admission ({} RAM units and a CPU core)",
+                     task.host, static_cast<int>(sim.now()), task.name, task.ram);
 
-    co_await host->ram.get(task.ram);
+        enter(TaskPhase::WaitingAdmission);
+        bump<int64_t>(host_counters.cpu_waiting);
+        record(ResourceRecorder::host_series(task.host_index, SeriesKind::CpuWaiting), 1);
+        co_await (*ctx.admission)[task.host_index].admit(task.group_index, task.ram);
+        record(ResourceRecorder::host_series(task.host_index, SeriesKind::RamLevel), -task.ram);
+        host_counters.ram_level.store(static_cast<int64_t>(host->ram.level()), std::memory_order_relaxed);
+    } else {
+        // Wait for available RAM (task will block until enough RAM is available)
+        logger::debug("[{}]\t[t={}]\tTask {}: Waiting for {} RAM units",
+                     task.host, static_cast<int>(sim.now()), task.name, task.ram);
 
-    // Wait for available CPU core
-    logger::debug("[{}]\t[t={}]\tTask {}: Waiting for CPU core",
-                 task.host, static_cast<int>(sim.now()), task.name);
+        enter(TaskPhase::WaitingRam);
+        bump<int64_t>(host_counters.ram_waiting);
+        record(ResourceRecorder::host_series(task.host_index, SeriesKind::RamWaiting), 1);
+        bool ram_blocked = host->ram.level() < static_cast<uint64_t>(task.ram);
+        co_await host->ram.get(task.ram);
+        if (quantum) hand_over(ram_blocked, quantum->ram_release[task.host_index]);
+        bump<int64_t>(host_counters.ram_waiting, -1);
+        record(ResourceRecorder::host_series(task.host_index, SeriesKind::RamWaiting), -1);
+        record(ResourceRecorder::host_series(task.host_index, SeriesKind::RamLevel), -task.ram);
+        host_counters.ram_level.store(static_cast<int64_t>(host->ram.level()), std::memory_order_relaxed);
 
-    auto cpu_req = host->cpu.request();
-    co_await cpu_req;
+        // Wait for available CPU core
+        logger::debug("[{}]\t[t={}]\tTask {}: Waiting for CPU core",
+                     task.host, static_cast<int>(sim.now()), task.name);
+
+        enter(TaskPhase::WaitingCpu);
+        bump<int64_t>(host_counters.cpu_waiting);
+        record(ResourceRecorder::host_series(task.host_index, SeriesKind::CpuWaiting), 1);
+        bool cpu_blocked = host->cpu.available() == 0;
+        core = co_await host->cpu.acquire();
+        if (quantum) hand_over(cpu_blocked, quantum->cpu_release[task.host_index]);
+    }
+    bump<int64_t>(host_counters.cpu_waiting, -1);
+    bump<int64_t>(host_counters.cpu_busy);
+    record(ResourceRecorder::host_series(task.host_index, SeriesKind::CpuWaiting), -1);
+    record(ResourceRecorder::host_series(task.host_index, SeriesKind::CpuBusy), 1);
+    records[task_index].start = static_cast<int64_t>(sim.now());
+    enter(TaskPhase::Running);
+    if (ctx.grants) {
+        ctx.grants->push_back(GrantStep{static_cast<uint32_t>(task_index), GrantStep::kCoreGrant, 0});
+    }
+    if (ctx.task_started) {
+        if (auto it = ctx.task_started->find(task_index); it != ctx.task_started->end()) {
+            it->second.trigger();
+        }
+    }
 
     logger::info("[{}]\t[t={}]\tTask {}: Started execution (CPU acquired, {} RAM allocated)",
                 task.host, static_cast<int>(sim.now()), task.name, task.ram);
 
-    // Step 5: Execute task (occupy CPU for run_time)
-    co_await sim.timeout(task.run_time);
+    // Step 5: Execute task (occupy CPU for run_time scaled by host speed)
+    if (ctx.stragglers) {
+        co_await speculative_execution(sim, ctx, task_index);
+    } else {
+        co_await wait_for(task.exec_time);
+        records[task_index].finish = static_cast<int64_t>(sim.now());
+    }
+
+    // A pipelined task cannot finish before the last chunk of its inputs
+    if (!streams.empty()) {
+        enter(TaskPhase::WaitingStream);
+        for (auto& stream : streams) {
+            co_await stream;
+        }
+        records[task_index].finish = static_cast<int64_t>(sim.now());
+    }
 
     logger::info("[{}]\t[t={}]\tTask {}: Finished execution",
                 task.host, static_cast<int>(sim.now()), task.name);
 
     // Step 6: Release resources
-    host->cpu.release();
-    co_await host->ram.put(task.ram);
+    if (quantum) {
+        quantum->task_finish[task_index] = exact;
+        quantum->cpu_release[task.host_index] = exact;
+        quantum->ram_release[task.host_index] = exact;
+    }
+    bump<int64_t>(host_counters.cpu_busy, -1);
+    record(ResourceRecorder::host_series(task.host_index, SeriesKind::CpuBusy), -1);
+    record(ResourceRecorder::host_series(task.host_index, SeriesKind::RamLevel), task.ram);
+    if (ctx.admission) {
+        (*ctx.admission)[task.host_index].release(task.group_index, task.ram);
+    } else {
+        core.release();
+        co_await host->ram.put(task.ram);
+    }
+    host_counters.ram_level.store(static_cast<int64_t>(host->ram.level()), std::memory_order_relaxed);
+    if (pooled) {
+        ctx.autoscaler->release(task_index);
+    }
 
     logger::debug("[{}]\t[t={}]\tTask {}: Released {} RAM units",
                  task.host, static_cast<int>(sim.now()), task.name, task.ram);
 
     // Step 7: Mark task as completed, O(1) access
+    enter(TaskPhase::Done);
+    if (ctx.rows) {
+        const auto& done = records[task_index];
+        ctx.rows->push(TaskRow{static_cast<uint32_t>(task_index), static_cast<uint32_t>(task.host_index),
+                               done.ready, done.start, done.finish, done.dependency_wait,
+                               done.link_wait, done.transfer, done.ram_wait, done.cpu_wait});
+    }
     task_completed[task_index].trigger();
+    bump<uint64_t>(ctx.counters.tasks_completed);
+}
+
+// Members after the head of a coarsened chain. Their host never makes a
+// task wait, so each starts once its initial sleep is over and its
+// predecessor has finished; one timeout stands in for all their events.
+static simcpp20::process<> chain_process(
+    simcpp20::simulation<>& sim,
+    SimulationContext& ctx,
+    const std::vector<size_t>& chain) {
+
+    co_await ctx.task_completed[chain.front()];
+    int64_t finish = ctx.records[chain.front()].finish;
+    for (size_t k = 1; k < chain.size(); ++k) {
+        const auto& task = ctx.tasks[chain[k]];
+        finish = std::max<int64_t>(task.initial_sleep_time, finish) + task.exec_time;
+    }
+    co_await sim.timeout(finish - static_cast<int64_t>(sim.now()));
+
+    // Timings as the members' own processes would have recorded them
+    int64_t previous = ctx.records[chain.front()].finish;
+    for (size_t k = 1; k < chain.size(); ++k) {
+        const auto& task = ctx.tasks[chain[k]];
+        auto& record = ctx.records[chain[k]];
+        record.dependency_wait = std::max<int64_t>(previous - task.initial_sleep_time, 0);
+        record.ready = std::max<int64_t>(task.initial_sleep_time, previous);
+        record.start = record.ready;
+        record.finish = record.start + task.exec_time;
+        record.phase = TaskPhase::Done;
+        record.phase_since = record.finish;
+        previous = record.finish;
+    }
+    ctx.task_completed[chain.back()].trigger();
+    bump<uint64_t>(ctx.counters.tasks_completed, chain.size() - 1);
+}
+
+// First of two events. Kept out of the coroutines: GCC mishandles
+// initializer lists inside co_await expressions
+static simcpp20::event<> either(simcpp20::simulation<>& sim, simcpp20::event<> a, simcpp20::event<> b) {
+    return sim.any_of({a, b});
+}
+
+// Backup copy of a straggling task on `host_index`. Each wait also ends on
+// `cancel`; a cancelled copy gives back what it holds and returns.
+static simcpp20::process<> backup_process(
+    simcpp20::simulation<>& sim,
+    SimulationContext& ctx,
+    size_t task_index,
+    size_t host_index,
+    simcpp20::event<> cancel) {
+
+    const auto& task = ctx.tasks[task_index];
+    auto host = ctx.hosts[host_index];
+    auto& host_counters = ctx.counters.hosts[host_index];
+    auto& state = *ctx.stragglers;
+    auto record = [&](SeriesKind kind, int64_t delta) {
+        if (ctx.recorder) {
+            ctx.recorder->add(ResourceRecorder::host_series(host_index, kind), static_cast<int64_t>(sim.now()), delta);
+        }
+    };
+    auto return_ram = [&]() -> simcpp20::event<> {
+        record(SeriesKind::RamLevel, task.ram);
+        auto put = host->ram.put(task.ram);
+        host_counters.ram_level.store(static_cast<int64_t>(host->ram.level()), std::memory_order_relaxed);
+        return put;
+    };
+
+    auto ram_req = host->ram.get(task.ram);
+    co_await either(sim, ram_req, cancel);
+    if (cancel.triggered()) {
+        ++state.cancelled;
+        if (!ram_req.triggered()) {
+            ram_req.abort();  // Withdraw from the RAM queue
+            co_return;
+        }
+        record(SeriesKind::RamLevel, -task.ram);
+        co_await return_ram();
+        co_return;
+    }
+    record(SeriesKind::RamLevel, -task.ram);
+    host_counters.ram_level.store(static_cast<int64_t>(host->ram.level()), std::memory_order_relaxed);
+
+    auto cpu_req = host->cpu.request();
+    co_await either(sim, cpu_req, cancel);
+    if (cancel.triggered()) {
+        ++state.cancelled;
+        if (cpu_req.triggered()) {
+            host->cpu.release();
+        } else {
+            cpu_req.abort();  // Withdraw from the CPU queue
+        }
+        co_await return_ram();
+        co_return;
+    }
+    bump<int64_t>(host_counters.cpu_busy);
+    record(SeriesKind::CpuBusy, 1);
+
+    logger::info("[{}]\t[t={}]\tTask {}: Started backup copy", host->name, static_cast<int>(sim.now()), task.name);
+
+    int64_t start = static_cast<int64_t>(sim.now());
+    auto run = sim.timeout(host->execution_time(task));
+    co_await either(sim, run, cancel);
+    int64_t now = static_cast<int64_t>(sim.now());
+    if (run.processed() && ctx.records[task_index].finish < 0) {
+        ctx.records[task_index].finish = now;
+        ++state.backups_won;
+        logger::info("[{}]\t[t={}]\tTask {}: Backup copy finished first", host->name, static_cast<int>(now), task.name);
+    } else {
+        if (!run.processed()) ++state.cancelled;
+        state.wasted_time += now - start;
+    }
+
+    host->cpu.release();
+    bump<int64_t>(host_counters.cpu_busy, -1);
+    record(SeriesKind::CpuBusy, -1);
+    co_await return_ram();
+}
+
+// Host for a backup copy: the one with the most free cores (then free RAM)
+// among the other hosts that can fit the task, SIZE_MAX if there is none
+static size_t backup_host(const SimulationContext& ctx, const models::Task& task) {
+    size_t best = SIZE_MAX;
+    for (size_t i = 0; i < ctx.hosts.size(); ++i) {
+        const auto& host = *ctx.hosts[i];
+        if (i == task.host_index || host.ram_capacity < task.ram) continue;
+        if (best == SIZE_MAX ||
+            std::pair(host.cpu.available(), host.ram.level()) >
+                std::pair(ctx.hosts[best]->cpu.available(), ctx.hosts[best]->ram.level())) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+simcpp20::process<> speculative_execution(
+    simcpp20::simulation<>& sim,
+    SimulationContext& ctx,
+    size_t task_index) {
+
+    const auto& task = ctx.tasks[task_index];
+    auto& state = *ctx.stragglers;
+    auto& record = ctx.records[task_index];
+    int64_t start = static_cast<int64_t>(sim.now());
+
+    // A cancelled timer stays scheduled but wakes no one
+    auto run = sim.timeout(state.exec_time[task_index]);
+    if (state.threshold > 0.0 && task.exec_time > 0) {
+        auto deadline = sim.timeout(static_cast<int64_t>(std::ceil(state.threshold * task.exec_time)));
+        co_await either(sim, run, deadline);
+
+        size_t host_index = run.processed() ? SIZE_MAX : backup_host(ctx, task);
+        if (host_index != SIZE_MAX) {
+            logger::info("[{}]\t[t={}]\tTask {}: Running past {}x its expected time, launching backup on {}",
+                        task.host, static_cast<int>(sim.now()), task.name, state.threshold,
+                        ctx.hosts[host_index]->name);
+            ++state.backups;
+            auto cancel = sim.event();
+            auto backup = backup_process(sim, ctx, task_index, host_index, cancel);
+            co_await either(sim, run, backup);
+
+            if (record.finish >= 0) {
+                // The backup won: this copy stops and gives back its core
+                ++state.cancelled;
+                state.wasted_time += static_cast<int64_t>(sim.now()) - start;
+                co_return;
+            }
+            cancel.trigger();
+        }
+    }
+
+    if (!run.processed()) {
+        co_await run;
+    }
+    record.finish = static_cast<int64_t>(sim.now());
+}
+
+StragglerState draw_stragglers(const models::StragglerConfig& config, const std::vector<models::Task>& tasks) {
+    StragglerState state;
+    state.exec_time.reserve(tasks.size());
+    std::mt19937_64 rng(config.seed);
+    auto uniform = [&rng] { return static_cast<double>(rng() >> 11) * 0x1.0p-53; };
+    for (const auto& task : tasks) {
+        int64_t exec_time = task.exec_time;
+        if (config.probability > 0.0 && uniform() < config.probability) {
+            exec_time = std::llround(task.exec_time * config.slowdown_at(uniform()));
+            ++state.stragglers;
+            state.slowdown_time += exec_time - task.exec_time;
+        }
+        state.exec_time.push_back(exec_time);
+    }
+    return state;
 }
 
 // TaskSimulator implementation
 
 TaskSimulator::TaskSimulator(const models::ExperimentConfig& config,
-                             std::vector<models::Task>&& tasks)
-    : tasks_(std::move(tasks)) {
+                             std::vector<models::Task>&& tasks) {
     init(config, std::move(tasks));
 }
 
@@ -161,33 +1038,128 @@ void TaskSimulator::init(const models::ExperimentConfig& config, std::vector<mod
         }
     }
 
-    // Create hosts and build host name to index mapping
+    // Start events only for producers of pipelined dependencies
+    for (const auto& task : tasks_) {
+        if (task.pipelined()) {
+            for (size_t dep_index : task.dependency_indices) {
+                task_started_.try_emplace(dep_index, sim_.event());
+            }
+        }
+    }
+
+    // Create hosts and build host name to index mapping. Room for every
+    // pool host up front: task processes hold references into hosts_
     std::unordered_map<std::string, size_t> host_name_to_index;
+    autoscaling_ = config.autoscaling;
+    size_t pool_slots = autoscaling_.enabled ? autoscaling_.max_hosts : 0;
+    hosts_.reserve(config.hosts.size() + pool_slots);
 
     for (const auto& [host_id, host_config] : config.hosts) {
         size_t host_index = hosts_.size();
         hosts_.push_back(std::make_shared<Host>(
-            sim_, host_id, host_config.cpu_cores, host_config.ram));
+            sim_, host_id, host_config.cpu_cores, host_config.ram,
+            host_config.speed, host_config.class_speeds));
         host_name_to_index[host_id] = host_index;
     }
 
-    // Convert task host names to indices and validate
+    // Convert task host names to indices and validate. Pool tasks are
+    // placed during the run (host_index SIZE_MAX until then)
     for (auto& task : tasks_) {
+        if (autoscaling_.enabled && task.host == autoscaling_.pool) {
+            const auto& pool_host = autoscaling_.host;
+            if (task.ram > pool_host.ram) {
+                throw std::runtime_error("Task '" + task.name + "' needs more RAM than a pool host has");
+            }
+            task.host_index = SIZE_MAX;
+            task.exec_time = scaled_run_time(task, pool_host.speed, pool_host.class_speeds);
+            continue;
+        }
         auto it = host_name_to_index.find(task.host);
         if (it == host_name_to_index.end()) {
             throw std::runtime_error("Task '" + task.name + "' references unknown host: '" + task.host + "'");
         }
         task.host_index = it->second;
+        task.exec_time = hosts_[task.host_index]->execution_time(task);
+    }
+
+    // Task groups in order of first appearance
+    std::unordered_map<std::string, size_t> group_to_index;
+    for (auto& task : tasks_) {
+        auto [it, inserted] = group_to_index.try_emplace(task.group, group_names_.size());
+        if (inserted) {
+            group_names_.push_back(task.group.empty() ? "default" : task.group);
+        }
+        task.group_index = it->second;
+    }
+    if (config.admission == models::AdmissionPolicy::Drf) {
+        admission_.reserve(hosts_.size());
+        for (const auto& host : hosts_) {
+            admission_.emplace_back(sim_, *host);
+        }
+    }
+
+    const auto& straggler_config = config.stragglers;
+    if (straggler_config.probability > 0.0 || config.speculation.enabled) {
+        stragglers_ = std::make_unique<StragglerState>(draw_stragglers(straggler_config, tasks_));
+
+        // Percentile of the expected runtime: 1x below the straggler mass,
+        // inside the slowdown distribution above it
+        if (config.speculation.enabled) {
+            double q = config.speculation.percentile / 100.0;
+            double p = straggler_config.probability;
+            stragglers_->threshold = q <= 1.0 - p ? 1.0 : straggler_config.slowdown_at((q - (1.0 - p)) / p);
+        }
+    }
+
+    if (autoscaling_.enabled && (config.admission == models::AdmissionPolicy::Drf || stragglers_)) {
+        throw std::invalid_argument("Autoscaling does not support stragglers, speculation or DRF admission");
+    }
+
+    // Backup copies take and return cores and RAM outside the DRF queue, so
+    // their releases would never admit the tasks waiting in it
+    if (config.admission == models::AdmissionPolicy::Drf && config.speculation.enabled) {
+        throw std::invalid_argument("DRF admission does not support speculation");
+    }
+
+    // Link clocks time a transfer when it is requested, which a pipelined
+    // consumer cannot do: how much it sends depends on when the link frees
+    if (config.link_model == models::LinkModel::Clock && !task_started_.empty()) {
+        throw std::invalid_argument("Link clocks do not support pipelined dependencies");
     }
 
     // Create network link
-    network_ = std::make_shared<NetworkLink>(sim_, hosts_.size());
+    network_ = std::make_shared<NetworkLink>(sim_, hosts_.size(), config.link_model);
+    for (const auto& link : config.link_scales) {
+        auto from = host_name_to_index.find(link.from);
+        auto to = host_name_to_index.find(link.to);
+        if (from == host_name_to_index.end() || to == host_name_to_index.end()) {
+            throw std::runtime_error("Link scale references unknown host: '" + link.from + "' -> '" + link.to + "'");
+        }
+        link.validate();
+        network_->set_scale(from->second, to->second, link.scale);
+    }
+
+    // Live per-host gauges, sized once before any sampler can read them,
+    // with an entry for every pool host slot
+    size_t static_hosts = hosts_.size();
+    if (autoscaling_.enabled) {
+        autoscaler_ = std::make_unique<Autoscaler>(sim_, autoscaling_, tasks_, hosts_, *network_, counters_);
+    }
+    auto host_names = all_host_names();
+    counters_.hosts = std::vector<HostCounters>(host_names.size());
+    for (size_t i = 0; i < host_names.size(); ++i) {
+        const auto& host_config = i < static_hosts ? config.hosts.at(host_names[i]) : autoscaling_.host;
+        counters_.hosts[i].name = host_names[i];
+        counters_.hosts[i].cpu_cores = host_config.cpu_cores;
+        counters_.hosts[i].ram_level.store(host_config.ram, std::memory_order_relaxed);
+    }
 
     // Create task completion events as a vector for O(1) access
     task_completed_.reserve(tasks_.size());
     for (size_t i = 0; i < tasks_.size(); ++i) {
         task_completed_.emplace_back(sim_.event());
     }
+    records_.assign(tasks_.size(), TaskRecord{});
 
     inited_ = true;
 }
@@ -201,32 +1173,99 @@ void TaskSimulator::run(bool verbose) {
     logger::info("Starting simulation with {} tasks", tasks_.size());
     logger::info("======================================================================");
 
-    // Calculate total CPU work time and per-host statistics
-    int64_t total_cpu_work = 0;
-    std::unordered_map<std::string, int64_t> cpu_work_per_host;
-
-    for (const auto& task : tasks_) {
-        total_cpu_work += task.run_time;
-        cpu_work_per_host[task.host] += task.run_time;
-    }
+    counters_.tasks_total.store(tasks_.size(), std::memory_order_relaxed);
 
     // Schedule all tasks (start their coroutines)
+    SimulationContext ctx{tasks_, hosts_, network_, task_completed_, records_, counters_, recorder_.get(), quantum_.get(),
+                          task_rows_.get(), stragglers_.get(),
+                          admission_.empty() ? nullptr : &admission_, autoscaler_.get(),
+                          task_started_.empty() ? nullptr : &task_started_,
+                          grants_enabled_ ? &grants_ : nullptr};
+    std::vector<bool> coarsened(tasks_.size(), false);
+    for (const auto& chain : chains_) {
+        for (size_t k = 1; k < chain.size(); ++k) {
+            coarsened[chain[k]] = true;
+        }
+    }
     for (size_t i = 0; i < tasks_.size(); ++i) {
-        task_process(sim_, tasks_[i], i, hosts_, network_, task_completed_, tasks_);
+        if (!coarsened[i]) {
+            task_process(sim_, ctx, i);
+        }
+    }
+    for (const auto& chain : chains_) {
+        chain_process(sim_, ctx, chain);
+    }
+    if (!chains_.empty()) {
+        logger::info("Coarsened {} tasks into {} macro-tasks", coarsened_tasks_, chains_.size());
+    }
+    if (autoscaler_) {
+        autoscaler_process(sim_, *autoscaler_);
+    }
+
+    // Run simulation event by event, publishing live counters in between
+    uint64_t events = 0;
+    while (!sim_.empty()) {
+        sim_.step();
+        counters_.events.store(++events, std::memory_order_relaxed);
+        counters_.sim_time.store(static_cast<int64_t>(sim_.now()), std::memory_order_relaxed);
+
+        // Safe point between events: no process is mid-step
+        if (state_dump_requested.load(std::memory_order_relaxed)) {
+            state_dump_requested.store(false, std::memory_order_relaxed);
+            logger::info("{}", state_dump());
+        }
+    }
+    counters_.finished.store(true, std::memory_order_relaxed);
+
+    if (task_rows_) {
+        task_rows_->close();
+        logger::info("Wrote {} task rows to {} ({} writer stalls)",
+                     task_rows_->rows(), task_rows_->path(), task_rows_->stalls());
+    }
+
+    // An empty queue with tasks left means they wait on resources that are
+    // never released
+    size_t completed = counters_.tasks_completed.load(std::memory_order_relaxed);
+    if (completed < tasks_.size()) {
+        throw std::runtime_error("Simulation stalled at t=" + std::to_string(static_cast<int64_t>(sim_.now())) +
+                                 ": " + std::to_string(tasks_.size() - completed) + " of " +
+                                 std::to_string(tasks_.size()) + " tasks never completed");
     }
 
-    // Run simulation
-    sim_.run();
+    // Calculate total CPU work time and per-host statistics (after the run:
+    // pool tasks only have a host once placed). Work is the time tasks
+    // actually occupy cores, i.e. run_time normalized by host speed
+    int64_t total_cpu_work = 0;
+    int64_t total_reference_work = 0;
+    std::unordered_map<std::string, int64_t> cpu_work_per_host;
+    std::unordered_map<std::string, int64_t> reference_work_per_host;
+
+    for (const auto& task : tasks_) {
+        total_cpu_work += task.exec_time;
+        total_reference_work += task.run_time;
+        cpu_work_per_host[task.host] += task.exec_time;
+        reference_work_per_host[task.host] += task.run_time;
+    }
 
-    // Calculate metrics
+    // Calculate metrics. Timers of cancelled copies and of the autoscaler
+    // still advance the clock, so with either the run ends at the last finish
     int64_t simulation_time = static_cast<int64_t>(sim_.now());
+    if (stragglers_ || autoscaler_) {
+        simulation_time = 0;
+        for (const auto& record : records_) {
+            simulation_time = std::max(simulation_time, record.finish);
+        }
+    }
+    makespan_ = simulation_time;
 
-    // Calculate total available CPU time across all hosts
+    // Calculate total available CPU time across all hosts (pool hosts only
+    // count while provisioned)
     int64_t total_cpu_cores = 0;
-    for (const auto& host : hosts_) {
-        total_cpu_cores += host->cpu_cores;
+    int64_t total_cpu_time_available = 0;
+    for (size_t h = 0; h < hosts_.size(); ++h) {
+        total_cpu_cores += hosts_[h]->cpu_cores;
+        total_cpu_time_available += hosts_[h]->cpu_cores * host_time(h);
     }
-    int64_t total_cpu_time_available = total_cpu_cores * simulation_time;
 
     // Calculate CPU utilization
     double cpu_utilization = (total_cpu_time_available > 0)
@@ -244,17 +1283,21 @@ void TaskSimulator::run(bool verbose) {
         logger::info("Host Statistics:");
         logger::info("----------------------------------------------------------------------");
 
-        for (const auto& host : hosts_) {
+        for (size_t h = 0; h < hosts_.size(); ++h) {
+            const auto& host = hosts_[h];
             int64_t host_cpu_work = cpu_work_per_host[host->name];
-            int64_t host_cpu_available = host->cpu_cores * simulation_time;
+            int64_t host_cpu_available = host->cpu_cores * host_time(h);
             double host_utilization = (host_cpu_available > 0)
                 ? (static_cast<double>(host_cpu_work) / host_cpu_available * 100.0)
                 : 0.0;
 
-            logger::info("{} ({} cores):", host->name, host->cpu_cores);
+            logger::info("{} ({} cores, speed {}):", host->name, host->cpu_cores, host->speed);
             logger::info("  CPU work time:      {}", host_cpu_work);
+            if (reference_work_per_host[host->name] != host_cpu_work) {
+                logger::info("  Reference work:     {} (at speed 1)", reference_work_per_host[host->name]);
+            }
             logger::info("  CPU available time: {} ({} cores × {})",
-                        host_cpu_available, host->cpu_cores, simulation_time);
+                        host_cpu_available, host->cpu_cores, host_time(h));
             logger::info("  CPU idle time:      {}", host_cpu_available - host_cpu_work);
             logger::info("  CPU utilization:    {:.2f}%", host_utilization);
         }
@@ -267,16 +1310,22 @@ void TaskSimulator::run(bool verbose) {
     logger::info("----------------------------------------------------------------------");
     logger::info("Total CPU cores:        {}", total_cpu_cores);
     logger::info("Total CPU work time:    {}", total_cpu_work);
+    if (total_reference_work != total_cpu_work) {
+        logger::info("Total reference work:   {} (at speed 1)", total_reference_work);
+    }
 
     // Detailed breakdown of CPU available time
     if (verbose) {
         logger::info("Total CPU available:    {}", total_cpu_time_available);
         logger::info("  Breakdown:");
-        for (const auto& host : hosts_) {
-            int64_t host_cpu_available = host->cpu_cores * simulation_time;
+        for (size_t h = 0; h < hosts_.size(); ++h) {
+            const auto& host = hosts_[h];
+            int64_t host_cpu_available = host->cpu_cores * host_time(h);
             logger::info("    {}: {} cores × {} = {}",
-                        host->name, host->cpu_cores, simulation_time, host_cpu_available);
+                        host->name, host->cpu_cores, host_time(h), host_cpu_available);
         }
+    } else if (autoscaler_) {
+        logger::info("Total CPU available:    {} (pool hosts while provisioned)", total_cpu_time_available);
     } else {
         logger::info("Total CPU available:    {} ({} cores × {})",
                     total_cpu_time_available, total_cpu_cores, simulation_time);
@@ -284,7 +1333,263 @@ void TaskSimulator::run(bool verbose) {
 
     logger::info("Total CPU idle time:    {}", idle_time);
     logger::info("CPU utilization:        {:.2f}%", cpu_utilization);
+    if (stragglers_) {
+        logger::info("Stragglers:             {} tasks slowed (+{} time units)",
+                    stragglers_->stragglers, stragglers_->slowdown_time);
+        if (stragglers_->threshold > 0.0) {
+            logger::info("Speculation:            {} backups after {:.2f}x expected time ({} won, "
+                        "{} copies cancelled, {} core time wasted)",
+                        stragglers_->backups, stragglers_->threshold, stragglers_->backups_won,
+                        stragglers_->cancelled, stragglers_->wasted_time);
+        }
+    }
+    if (autoscaler_) {
+        int64_t pool_time = autoscaler_->pool_host_time(simulation_time);
+        int64_t static_time = static_cast<int64_t>(autoscaler_->first_index()) * simulation_time;
+        logger::info("Autoscaling:            {} scale-ups, {} scale-downs, peak {} pool hosts",
+                    autoscaler_->scale_ups(), autoscaler_->scale_downs(), autoscaler_->peak_hosts());
+        logger::info("Cost:                   {} host-time ({} pool, {} static) for makespan {}",
+                    pool_time + static_time, pool_time, static_time, simulation_time);
+    }
+    if (group_names_.size() > 1) {
+        logger::info("Group statistics:");
+        for (const auto& group : group_stats()) {
+            logger::info("  {}: {} tasks, throughput {:.4f} tasks/time unit, slowdown mean {:.2f} max {:.2f}",
+                        group.name, group.tasks, group.throughput, group.mean_slowdown, group.max_slowdown);
+        }
+    }
+    if (quantum_) {
+        logger::info("Time quantum:           {} ({} tick events, {} events total)",
+                    quantum_->quantum(), quantum_->ticks(), events);
+    }
     logger::info("======================================================================");
 }
 
+std::vector<GroupStats> TaskSimulator::group_stats() const {
+    std::vector<GroupStats> stats(group_names_.size());
+    std::vector<size_t> timed(group_names_.size(), 0);
+    for (size_t g = 0; g < stats.size(); ++g) {
+        stats[g].name = group_names_[g];
+    }
+
+    for (const auto& task : tasks_) {
+        auto& group = stats[task.group_index];
+        const auto& record = records_[task.index];
+        ++group.tasks;
+        if (record.finish >= 0 && task.exec_time > 0) {
+            double slowdown = static_cast<double>(record.finish - record.ready) / task.exec_time;
+            group.mean_slowdown += slowdown;
+            group.max_slowdown = std::max(group.max_slowdown, slowdown);
+            ++timed[task.group_index];
+        }
+    }
+
+    for (size_t g = 0; g < stats.size(); ++g) {
+        if (timed[g] > 0) stats[g].mean_slowdown /= static_cast<double>(timed[g]);
+        if (makespan_ > 0) stats[g].throughput = static_cast<double>(stats[g].tasks) / static_cast<double>(makespan_);
+    }
+    return stats;
+}
+
+void TaskSimulator::enable_timeseries() {
+    if (!inited_) {
+        throw std::runtime_error("TaskSimulator not initialized. Call init() before enable_timeseries().");
+    }
+    if (coarsening_ || network_->model() == models::LinkModel::Clock) {
+        throw std::invalid_argument("Time series are not supported with chain coarsening or link clocks");
+    }
+
+    auto host_names = all_host_names();
+    std::vector<int64_t> ram_capacity;
+    for (size_t i = 0; i < host_names.size(); ++i) {
+        ram_capacity.push_back(i < hosts_.size() && (!autoscaler_ || i < autoscaler_->first_index())
+                               ? hosts_[i]->ram_capacity : autoscaling_.host.ram);
+    }
+    recorder_ = std::make_unique<ResourceRecorder>(host_names, ram_capacity);
+}
+
+void TaskSimulator::set_quantum(int64_t quantum) {
+    if (!inited_) {
+        throw std::runtime_error("TaskSimulator not initialized. Call init() before set_quantum().");
+    }
+    if (stragglers_ || !admission_.empty() || autoscaler_ || !task_started_.empty() || coarsening_ ||
+        network_->model() == models::LinkModel::Clock) {
+        throw std::invalid_argument("Approximate timing does not support stragglers, speculation, DRF admission, "
+                                    "autoscaling, pipelined dependencies, chain coarsening or link clocks");
+    }
+    quantum_ = std::make_unique<QuantumClock>(sim_, quantum, tasks_.size(), hosts_.size());
+}
+
+void TaskSimulator::enable_coarsening() {
+    if (!inited_) {
+        throw std::runtime_error("TaskSimulator not initialized. Call init() before enable_coarsening().");
+    }
+    if (quantum_ || recorder_ || task_rows_ || stragglers_ || !admission_.empty() || autoscaler_) {
+        throw std::invalid_argument("Chain coarsening does not support approximate timing, time series, task rows, "
+                                    "stragglers, speculation, DRF admission or autoscaling");
+    }
+    coarsening_ = true;
+    chains_.clear();
+    coarsened_tasks_ = 0;
+
+    // Link p -> c: same host, c depends on p alone, nothing else depends on p
+    // and c does not stream p's output
+    std::vector<size_t> dependents(tasks_.size(), 0);
+    for (const auto& task : tasks_) {
+        for (size_t dep_index : task.dependency_indices) {
+            ++dependents[dep_index];
+        }
+    }
+    std::vector<size_t> next(tasks_.size(), SIZE_MAX);
+    std::vector<bool> linked(tasks_.size(), false);
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+        const auto& task = tasks_[i];
+        if (task.dependency_indices.size() != 1 || task.pipelined()) continue;
+        size_t dep_index = task.dependency_indices.front();
+        if (dependents[dep_index] == 1 && tasks_[dep_index].host_index == task.host_index) {
+            next[dep_index] = i;
+            linked[i] = true;
+        }
+    }
+
+    // Every task belongs to one maximal chain, and a chain holds resources
+    // for one task at a time. A host whose chains fit its cores and, each
+    // at its largest task, its RAM never makes a task wait.
+    struct HostLoad {
+        int64_t chains = 0;
+        int64_t ram = 0;
+    };
+    std::vector<HostLoad> load(hosts_.size());
+    std::vector<std::vector<size_t>> candidates;
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+        if (linked[i]) continue;
+        std::vector<size_t> chain;
+        int max_ram = 0;
+        for (size_t k = i; k != SIZE_MAX; k = next[k]) {
+            chain.push_back(k);
+            max_ram = std::max(max_ram, tasks_[k].ram);
+        }
+        auto& host_load = load[tasks_[i].host_index];
+        ++host_load.chains;
+        host_load.ram += max_ram;
+
+        // Ending in a sink keeps the macro-task's timing out of every other
+        // task's event order; with fewer than two members after the head it
+        // would not save a process
+        if (chain.size() >= 3 && dependents[chain.back()] == 0) {
+            candidates.push_back(std::move(chain));
+        }
+    }
+
+    for (auto& chain : candidates) {
+        size_t host_index = tasks_[chain.front()].host_index;
+        const auto& host = *hosts_[host_index];
+        if (load[host_index].chains <= host.cpu_cores && load[host_index].ram <= host.ram_capacity) {
+            coarsened_tasks_ += chain.size() - 1;
+            chains_.push_back(std::move(chain));
+        }
+    }
+}
+
+void TaskSimulator::enable_task_rows(const std::string& path, TaskRowFormat format) {
+    if (!inited_) {
+        throw std::runtime_error("TaskSimulator not initialized. Call init() before enable_task_rows().");
+    }
+    if (coarsening_) {
+        throw std::invalid_argument("Task rows are not supported with chain coarsening");
+    }
+
+    task_names_.clear();
+    host_names_.clear();
+    for (const auto& task : tasks_) task_names_.push_back(task.name);
+    host_names_ = all_host_names();
+    task_rows_ = std::make_unique<TaskRowSink>(path, format, task_names_, host_names_);
+}
+
+int64_t TaskSimulator::host_time(size_t host_index) const {
+    return autoscaler_ ? autoscaler_->host_time(host_index, makespan_) : makespan_;
+}
+
+std::vector<std::string> TaskSimulator::all_host_names() const {
+    size_t static_hosts = autoscaler_ ? autoscaler_->first_index() : hosts_.size();
+    std::vector<std::string> names;
+    for (size_t i = 0; i < static_hosts; ++i) {
+        names.push_back(hosts_[i]->name);
+    }
+    for (size_t slot = 0; autoscaler_ && slot < autoscaling_.max_hosts; ++slot) {
+        names.push_back(autoscaler_->slot_name(slot));
+    }
+    return names;
+}
+
+void TaskSimulator::write_timeseries(const std::string& path, int64_t interval) const {
+    if (!recorder_) {
+        throw std::runtime_error("Time series recording was not enabled");
+    }
+    recorder_->write(path, interval);
+    logger::info("Wrote {} resource level changes (sampled every {}) to {}",
+                 recorder_->num_changes(), interval, path);
+}
+
+std::string TaskSimulator::state_dump(size_t top_n) const {
+    std::ostringstream out;
+    int64_t now = counters_.sim_time.load(std::memory_order_relaxed);
+
+    out << "State dump at t=" << now << " (events " << counters_.events.load(std::memory_order_relaxed)
+        << ", tasks completed " << counters_.tasks_completed.load(std::memory_order_relaxed)
+        << "/" << tasks_.size() << ")\n";
+
+    // Hosts ordered by waiter queue length
+    std::vector<size_t> host_order(counters_.hosts.size());
+    for (size_t i = 0; i < host_order.size(); ++i) host_order[i] = i;
+
+    auto print_queues = [&](const char* title, auto waiting) {
+        std::sort(host_order.begin(), host_order.end(), [&](size_t a, size_t b) {
+            return waiting(counters_.hosts[a]) > waiting(counters_.hosts[b]);
+        });
+        out << "  Longest " << title << " waiter queues:\n";
+        for (size_t i = 0; i < std::min(top_n, host_order.size()); ++i) {
+            const auto& host = counters_.hosts[host_order[i]];
+            if (waiting(host) == 0) break;
+            out << "    " << host.name << ": " << waiting(host) << " waiting, "
+                << host.cpu_busy.load(std::memory_order_relaxed) << "/" << host.cpu_cores << " cores busy, "
+                << host.ram_level.load(std::memory_order_relaxed) << " RAM free\n";
+        }
+    };
+    print_queues("CPU", [](const HostCounters& host) { return host.cpu_waiting.load(std::memory_order_relaxed); });
+    print_queues("RAM", [](const HostCounters& host) { return host.ram_waiting.load(std::memory_order_relaxed); });
+
+    // Busy links and pending tasks from the per-task phases
+    std::vector<size_t> pending;
+    out << "  Busy network links:\n";
+    for (size_t i = 0; i < tasks_.size(); ++i) {
+        const auto& record = records_[i];
+        if (record.phase == TaskPhase::Transferring) {
+            const auto& from = tasks_[record.peer];
+            out << "    " << from.host << " -> " << tasks_[i].host << ": " << from.name << " -> "
+                << tasks_[i].name << " since t=" << record.phase_since << "\n";
+        }
+        if (record.phase != TaskPhase::Done) {
+            pending.push_back(i);
+        }
+    }
+
+    size_t shown = std::min(top_n, pending.size());
+    std::partial_sort(pending.begin(), pending.begin() + shown, pending.end(), [&](size_t a, size_t b) {
+        return records_[a].phase_since < records_[b].phase_since;
+    });
+    out << "  Oldest pending tasks (" << pending.size() << " pending):";
+    for (size_t i = 0; i < shown; ++i) {
+        const auto& task = tasks_[pending[i]];
+        const auto& record = records_[pending[i]];
+        out << "\n    " << task.name << " on " << task.host << ": " << to_string(record.phase);
+        if (record.peer != SIZE_MAX) {
+            out << " " << tasks_[record.peer].name;
+        }
+        out << " since t=" << record.phase_since;
+    }
+
+    return out.str();
+}
+
 } // namespace simulator
@@ -0,0 +1,258 @@
+#include "../include/task_rows.hpp"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace simulator {
+
+// Columnar file layout (native byte order):
+//   char[8] magic, uint32 num_hosts, per host: uint16 name length, name bytes,
+//   uint64 num_tasks, per task: uint16 name length, name bytes,
+//   blocks of uint32 n (> 0) followed by the columns task[n], host[n] (uint32)
+//   and ready, start, finish, dependency_wait, link_wait, transfer,
+//   ram_wait, cpu_wait (int64, n each), terminated by a uint32 0
+static const char kMagic[8] = {'T', 'S', 'I', 'M', 'T', 'R', '1', '\0'};
+
+namespace {
+
+constexpr int64_t TaskRow::*kTimeColumns[] = {
+    &TaskRow::ready, &TaskRow::start, &TaskRow::finish,
+    &TaskRow::dependency_wait, &TaskRow::link_wait, &TaskRow::transfer,
+    &TaskRow::ram_wait, &TaskRow::cpu_wait};
+
+void append_number(std::string& out, int64_t value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+} // namespace
+
+TaskRowSink::TaskRowSink(const std::string& path, TaskRowFormat format,
+                         const std::vector<std::string>& task_names,
+                         const std::vector<std::string>& host_names,
+                         size_t rows_per_buffer)
+    : path_(path), format_(format), task_names_(task_names), host_names_(host_names),
+      rows_per_buffer_(rows_per_buffer) {
+    if (rows_per_buffer == 0) {
+        throw std::invalid_argument("Task row buffer size must be > 0");
+    }
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Failed to open task row file: " + path);
+    }
+    buffers_[0].reserve(rows_per_buffer);
+    buffers_[1].reserve(rows_per_buffer);
+    writer_ = std::thread(&TaskRowSink::write_loop, this);
+}
+
+TaskRowSink::~TaskRowSink() {
+    try {
+        close();
+    } catch (...) {
+        // Errors are only reported through an explicit close()
+    }
+}
+
+void TaskRowSink::hand_off() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (pending_) {
+        ++stalls_;
+        written_.wait(lock, [this] { return !pending_; });
+    }
+    rows_ += buffers_[active_].size();
+    active_ ^= 1;
+    pending_ = true;
+    handed_over_.notify_one();
+}
+
+void TaskRowSink::close() {
+    if (closed_) return;
+    closed_ = true;
+
+    if (!buffers_[active_].empty()) {
+        hand_off();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finishing_ = true;
+    }
+    handed_over_.notify_one();
+    writer_.join();
+
+    if (!error_) {
+        try {
+            if (format_ == TaskRowFormat::Columnar) {
+                uint32_t end = 0;
+                write_bytes(&end, sizeof(end));
+            }
+            file_.close();
+            if (!file_) {
+                throw std::runtime_error("Failed to write task row file: " + path_);
+            }
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+    }
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void TaskRowSink::write_loop() {
+    bool failed = false;
+    auto attempt = [&](auto&& write) {
+        if (failed) return;
+        try {
+            write();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = std::current_exception();
+            failed = true;
+        }
+    };
+
+    attempt([this] { write_header(); });
+    for (;;) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        handed_over_.wait(lock, [this] { return pending_ || finishing_; });
+        if (!pending_) break;
+        auto& buffer = buffers_[active_ ^ 1];
+        lock.unlock();
+
+        // After a write error rows are dropped so the simulation never waits
+        attempt([this, &buffer] { write_block(buffer); });
+        buffer.clear();
+
+        lock.lock();
+        pending_ = false;
+        written_.notify_one();
+    }
+}
+
+void TaskRowSink::write_bytes(const void* data, size_t size) {
+    file_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!file_) {
+        throw std::runtime_error("Failed to write task row file: " + path_);
+    }
+}
+
+void TaskRowSink::write_header() {
+    if (format_ == TaskRowFormat::Csv) {
+        static const char kHeader[] =
+            "TASK_NAME,TASK_HOST,READY,START,FINISH,DEPENDENCY_WAIT,LINK_WAIT,TRANSFER,RAM_WAIT,CPU_WAIT\n";
+        write_bytes(kHeader, sizeof(kHeader) - 1);
+        return;
+    }
+
+    auto put_names = [this](const std::vector<std::string>& names) {
+        for (const auto& name : names) {
+            auto length = static_cast<uint16_t>(name.size());
+            write_bytes(&length, sizeof(length));
+            write_bytes(name.data(), length);
+        }
+    };
+    write_bytes(kMagic, sizeof(kMagic));
+    auto num_hosts = static_cast<uint32_t>(host_names_.size());
+    write_bytes(&num_hosts, sizeof(num_hosts));
+    put_names(host_names_);
+    uint64_t num_tasks = task_names_.size();
+    write_bytes(&num_tasks, sizeof(num_tasks));
+    put_names(task_names_);
+}
+
+void TaskRowSink::write_block(const std::vector<TaskRow>& rows) {
+    if (format_ == TaskRowFormat::Csv) {
+        text_.clear();
+        for (const auto& row : rows) {
+            text_ += task_names_[row.task];
+            text_ += ',';
+            text_ += host_names_[row.host];
+            for (auto column : kTimeColumns) {
+                text_ += ',';
+                append_number(text_, row.*column);
+            }
+            text_ += '\n';
+        }
+        write_bytes(text_.data(), text_.size());
+        return;
+    }
+
+    // Transpose into one contiguous write per column
+    auto n = static_cast<uint32_t>(rows.size());
+    write_bytes(&n, sizeof(n));
+    std::vector<uint32_t> ids(n);
+    for (uint32_t i = 0; i < n; ++i) ids[i] = rows[i].task;
+    write_bytes(ids.data(), n * sizeof(uint32_t));
+    for (uint32_t i = 0; i < n; ++i) ids[i] = rows[i].host;
+    write_bytes(ids.data(), n * sizeof(uint32_t));
+
+    std::vector<int64_t> values(n);
+    for (auto column : kTimeColumns) {
+        for (uint32_t i = 0; i < n; ++i) values[i] = rows[i].*column;
+        write_bytes(values.data(), n * sizeof(int64_t));
+    }
+}
+
+TaskRowData read_task_rows(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open task row file: " + path);
+    }
+    auto get = [&file, &path](void* data, size_t size) {
+        if (!file.read(static_cast<char*>(data), static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("Truncated task row file: " + path);
+        }
+    };
+    auto get_names = [&get](std::vector<std::string>& names, uint64_t count) {
+        for (uint64_t i = 0; i < count; ++i) {
+            uint16_t length = 0;
+            get(&length, sizeof(length));
+            std::string name(length, '\0');
+            get(name.data(), length);
+            names.push_back(std::move(name));
+        }
+    };
+
+    char magic[sizeof(kMagic)];
+    get(magic, sizeof(magic));
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a columnar task row file: " + path);
+    }
+
+    TaskRowData data;
+    uint32_t num_hosts = 0;
+    get(&num_hosts, sizeof(num_hosts));
+    get_names(data.host_names, num_hosts);
+    uint64_t num_tasks = 0;
+    get(&num_tasks, sizeof(num_tasks));
+    get_names(data.task_names, num_tasks);
+
+    std::vector<int64_t>* time_columns[] = {
+        &data.ready, &data.start, &data.finish, &data.dependency_wait, &data.link_wait,
+        &data.transfer, &data.ram_wait, &data.cpu_wait};
+    for (;;) {
+        uint32_t n = 0;
+        get(&n, sizeof(n));
+        if (n == 0) break;
+
+        size_t offset = data.task.size();
+        for (auto* column : {&data.task, &data.host}) {
+            column->resize(offset + n);
+            get(column->data() + offset, n * sizeof(uint32_t));
+        }
+        for (auto* column : time_columns) {
+            column->resize(offset + n);
+            get(column->data() + offset, n * sizeof(int64_t));
+        }
+    }
+
+    for (size_t i = 0; i < data.task.size(); ++i) {
+        if (data.task[i] >= num_tasks || data.host[i] >= num_hosts) {
+            throw std::runtime_error("Task row file " + path + " references an unknown task or host");
+        }
+    }
+    return data;
+}
+
+} // namespace simulator
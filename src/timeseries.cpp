@@ -0,0 +1,185 @@
+#include "../include/timeseries.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace simulator {
+
+// File layout (native byte order):
+//   char[8] magic, int64 interval, uint32 num_series,
+//   per series: uint8 kind, uint16 name length, name bytes,
+//   uint64 num_samples, uint32 series[n], int64 time[n], int64 value[n]
+static const char kMagic[8] = {'T', 'S', 'I', 'M', 'T', 'S', '1', '\0'};
+
+const char* to_string(SeriesKind kind) {
+    switch (kind) {
+        case SeriesKind::RamLevel: return "ram_level";
+        case SeriesKind::RamWaiting: return "ram_waiting";
+        case SeriesKind::CpuBusy: return "cpu_busy";
+        case SeriesKind::CpuWaiting: return "cpu_waiting";
+        case SeriesKind::LinkBusy: return "link_busy";
+        case SeriesKind::LinkWaiting: return "link_waiting";
+    }
+    return "unknown";
+}
+
+ResourceRecorder::ResourceRecorder(const std::vector<std::string>& host_names,
+                                   const std::vector<int64_t>& ram_capacity)
+    : host_names_(host_names) {
+    for (size_t h = 0; h < host_names.size(); ++h) {
+        for (auto kind : {SeriesKind::RamLevel, SeriesKind::RamWaiting,
+                          SeriesKind::CpuBusy, SeriesKind::CpuWaiting}) {
+            kinds_.push_back(kind);
+            names_.push_back(host_names[h]);
+            int64_t initial = kind == SeriesKind::RamLevel ? ram_capacity[h] : 0;
+            initial_.push_back(initial);
+            current_.push_back(initial);
+        }
+    }
+}
+
+uint32_t ResourceRecorder::link_series(size_t from_host_index, size_t to_host_index) {
+    uint64_t key = (static_cast<uint64_t>(from_host_index) << 32) | to_host_index;
+    auto [it, inserted] = link_index_.try_emplace(key, static_cast<uint32_t>(kinds_.size()));
+    if (inserted) {
+        std::string name = host_names_[from_host_index] + "->" + host_names_[to_host_index];
+        for (auto kind : {SeriesKind::LinkBusy, SeriesKind::LinkWaiting}) {
+            kinds_.push_back(kind);
+            names_.push_back(name);
+            initial_.push_back(0);
+            current_.push_back(0);
+        }
+    }
+    return it->second;
+}
+
+void ResourceRecorder::write(const std::string& path, int64_t interval) const {
+    if (interval <= 0) {
+        throw std::invalid_argument("Time series interval must be > 0, got " + std::to_string(interval));
+    }
+
+    // Group the change log by series with a counting sort (stable, so
+    // changes stay in time order within each series)
+    size_t num_series = kinds_.size();
+    std::vector<size_t> offsets(num_series + 1, 0);
+    for (const auto& change : changes_) {
+        offsets[change.series + 1]++;
+    }
+    for (size_t i = 0; i < num_series; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    std::vector<const Change*> grouped(changes_.size());
+    {
+        auto cursor = offsets;
+        for (const auto& change : changes_) {
+            grouped[cursor[change.series]++] = &change;
+        }
+    }
+
+    // A change at time t is first visible at sample ceil(t / interval);
+    // several changes mapping to the same sample keep the last one
+    std::vector<uint32_t> sample_series;
+    std::vector<int64_t> sample_time;
+    std::vector<int64_t> sample_value;
+    for (uint32_t series = 0; series < num_series; ++series) {
+        // The initial value is pending for sample 0, so a change at time 0
+        // replaces it instead of producing two samples at the same time
+        bool any_emitted = false;
+        int64_t emitted = 0;
+        int64_t pending_sample = 0;
+        int64_t pending_value = initial_[series];
+        auto flush = [&]() {
+            if (!any_emitted || pending_value != emitted) {
+                any_emitted = true;
+                emitted = pending_value;
+                sample_series.push_back(series);
+                sample_time.push_back(pending_sample * interval);
+                sample_value.push_back(emitted);
+            }
+        };
+
+        for (size_t i = offsets[series]; i < offsets[series + 1]; ++i) {
+            int64_t sample = (grouped[i]->time + interval - 1) / interval;
+            if (sample != pending_sample) {
+                flush();
+                pending_sample = sample;
+            }
+            pending_value = grouped[i]->value;
+        }
+        flush();
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open time series file: " + path);
+    }
+    auto put = [&file](const void* data, size_t size) {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    };
+
+    put(kMagic, sizeof(kMagic));
+    put(&interval, sizeof(interval));
+    auto series_count = static_cast<uint32_t>(num_series);
+    put(&series_count, sizeof(series_count));
+    for (size_t i = 0; i < num_series; ++i) {
+        auto kind = static_cast<uint8_t>(kinds_[i]);
+        auto length = static_cast<uint16_t>(names_[i].size());
+        put(&kind, sizeof(kind));
+        put(&length, sizeof(length));
+        put(names_[i].data(), length);
+    }
+    uint64_t num_samples = sample_series.size();
+    put(&num_samples, sizeof(num_samples));
+    put(sample_series.data(), num_samples * sizeof(uint32_t));
+    put(sample_time.data(), num_samples * sizeof(int64_t));
+    put(sample_value.data(), num_samples * sizeof(int64_t));
+
+    if (!file) {
+        throw std::runtime_error("Failed to write time series file: " + path);
+    }
+}
+
+TimeSeriesData read_timeseries(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open time series file: " + path);
+    }
+    auto get = [&file, &path](void* data, size_t size) {
+        if (!file.read(static_cast<char*>(data), static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("Truncated time series file: " + path);
+        }
+    };
+
+    char magic[sizeof(kMagic)];
+    get(magic, sizeof(magic));
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a time series file: " + path);
+    }
+
+    TimeSeriesData data;
+    get(&data.interval, sizeof(data.interval));
+    uint32_t num_series = 0;
+    get(&num_series, sizeof(num_series));
+    for (uint32_t i = 0; i < num_series; ++i) {
+        uint8_t kind = 0;
+        uint16_t length = 0;
+        get(&kind, sizeof(kind));
+        get(&length, sizeof(length));
+        std::string name(length, '\0');
+        get(name.data(), length);
+        data.kinds.push_back(static_cast<SeriesKind>(kind));
+        data.names.push_back(std::move(name));
+    }
+
+    uint64_t num_samples = 0;
+    get(&num_samples, sizeof(num_samples));
+    data.sample_series.resize(num_samples);
+    data.sample_time.resize(num_samples);
+    data.sample_value.resize(num_samples);
+    get(data.sample_series.data(), num_samples * sizeof(uint32_t));
+    get(data.sample_time.data(), num_samples * sizeof(int64_t));
+    get(data.sample_value.data(), num_samples * sizeof(int64_t));
+    return data;
+}
+
+} // namespace simulator
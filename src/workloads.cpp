@@ -0,0 +1,97 @@
+#include "../include/workloads.h"
+#include <random>
+#include <stdexcept>
+
+namespace workloads {
+
+Kind parse_kind(const std::string& name) {
+    if (name == "chain") return Kind::Chain;
+    if (name == "ping_pong") return Kind::PingPong;
+    if (name == "fan_out") return Kind::FanOut;
+    if (name == "ram_contended") return Kind::RamContended;
+    throw std::invalid_argument("Unknown workload kind: '" + name +
+                                "'. Available kinds: chain, ping_pong, fan_out, ram_contended");
+}
+
+std::string kind_name(Kind kind) {
+    switch (kind) {
+        case Kind::Chain: return "chain";
+        case Kind::PingPong: return "ping_pong";
+        case Kind::FanOut: return "fan_out";
+        case Kind::RamContended: return "ram_contended";
+    }
+    return "unknown";
+}
+
+models::ExperimentConfig generate_config(size_t num_hosts, int cpu_cores, int ram) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+
+    for (size_t i = 0; i < num_hosts; ++i) {
+        config.hosts["HOST_" + std::to_string(i)] = models::HostConfig{cpu_cores, ram};
+    }
+
+    config.validate(true);
+    return config;
+}
+
+std::vector<models::Task> generate_tasks(Kind kind, size_t num_tasks, size_t num_hosts,
+                                         int host_ram) {
+    if (num_hosts == 0) {
+        throw std::invalid_argument("Workload needs at least one host");
+    }
+
+    std::mt19937 rng(static_cast<uint32_t>(num_tasks * 31 + num_hosts));
+    std::uniform_int_distribution<int> run_time(5, 15);
+
+    std::vector<models::Task> tasks;
+    tasks.reserve(num_tasks);
+
+    for (size_t i = 0; i < num_tasks; ++i) {
+        size_t host_idx = i % num_hosts;
+        int ram = 100;
+        int network_time = 0;
+        std::vector<std::string> dependencies;
+
+        switch (kind) {
+            case Kind::Chain:
+                if (i >= num_hosts) {
+                    dependencies.push_back("Task_" + std::to_string(i - num_hosts));
+                }
+                break;
+            case Kind::PingPong:
+                network_time = 5;
+                if (i >= 2) {
+                    dependencies.push_back("Task_" + std::to_string(i - 2));
+                }
+                break;
+            case Kind::FanOut:
+                network_time = 3;
+                if (i > 0) {
+                    dependencies.push_back("Task_" + std::to_string((i - 1) / 8));
+                }
+                break;
+            case Kind::RamContended:
+                ram = host_ram * std::uniform_int_distribution<int>(40, 60)(rng) / 100;
+                break;
+        }
+
+        models::Task task{
+            "Task_" + std::to_string(i),
+            "HOST_" + std::to_string(host_idx),
+            0,
+            run_time(rng),
+            ram,
+            network_time,
+            dependencies,
+            {},
+            i,
+            0
+        };
+        tasks.push_back(task);
+    }
+
+    return tasks;
+}
+
+} // namespace workloads
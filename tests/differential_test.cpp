@@ -0,0 +1,314 @@
+#include <gtest/gtest.h>
+#include "../include/csv_parser.h"
+#include "../include/simulator.hpp"
+#include "../include/lockstep.hpp"
+#include "../include/models.h"
+#include "../include/logger.hpp"
+#include <array>
+#include <functional>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Differential testing harness: a reference engine and a candidate engine
+// run the same randomly generated workloads and must produce identical
+// canonical trace digests. A failing workload is shrunk to a minimal CSV.
+
+struct Workload {
+    models::ExperimentConfig config;
+    std::vector<models::Task> tasks;
+};
+
+struct EngineResult {
+    uint64_t digest = 0;
+    std::vector<simulator::TaskRecord> records;
+};
+
+using Engine = std::function<EngineResult(const Workload&)>;
+
+// Reference engine: today's coroutine implementation
+static EngineResult run_reference(const Workload& workload) {
+    auto tasks = workload.tasks;
+    simulator::TaskSimulator sim(workload.config, std::move(tasks));
+    sim.run();
+    return {simulator::trace_digest(sim.tasks(), sim.records()), sim.records()};
+}
+
+class DifferentialTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        logger::set_level(spdlog::level::warn);
+    }
+
+    void TearDown() override {
+        logger::set_level(spdlog::level::info);
+    }
+
+    // Random workload with varying DAG shape, RAM pressure and network times
+    static Workload generate_workload(uint32_t seed) {
+        std::mt19937 rng(seed);
+        auto uniform = [&rng](int lo, int hi) {
+            return std::uniform_int_distribution<int>(lo, hi)(rng);
+        };
+
+        Workload workload;
+        workload.config.tasks_csv_path = "generated";
+
+        int num_hosts = uniform(1, 4);
+        std::vector<int> host_ram;
+        for (int h = 0; h < num_hosts; ++h) {
+            models::HostConfig host_config{uniform(1, 3), uniform(1000, 4000)};
+            host_ram.push_back(host_config.ram);
+            workload.config.hosts["HOST_" + std::to_string(h)] = host_config;
+        }
+
+        // 0 = independent, 1 = chain, 2 = fan-out, 3 = random DAG
+        int shape = uniform(0, 3);
+        double ram_pressure = std::array<double, 3>{0.1, 0.5, 1.0}[uniform(0, 2)];
+        int num_tasks = uniform(1, 40);
+
+        for (int i = 0; i < num_tasks; ++i) {
+            int host = uniform(0, num_hosts - 1);
+
+            std::vector<std::string> dependencies;
+            if (i > 0) {
+                if (shape == 1) {
+                    dependencies.push_back("T" + std::to_string(i - 1));
+                } else if (shape == 2) {
+                    dependencies.push_back("T0");
+                } else if (shape == 3 && uniform(0, 9) < 6) {
+                    dependencies.push_back("T" + std::to_string(uniform(0, i - 1)));
+                }
+            }
+
+            models::Task task{
+                "T" + std::to_string(i),
+                "HOST_" + std::to_string(host),
+                uniform(0, 9) < 3 ? uniform(0, 50) : 0,
+                uniform(0, 100),
+                uniform(0, static_cast<int>(host_ram[host] * ram_pressure)),
+                uniform(0, 30),
+                dependencies,
+                {},
+                static_cast<size_t>(i),
+                0
+            };
+            workload.tasks.push_back(task);
+        }
+
+        return workload;
+    }
+
+    static bool diverges(const Engine& reference, const Engine& candidate, const Workload& workload) {
+        return reference(workload).digest != candidate(workload).digest;
+    }
+
+    // Remove one task; dependents inherit its dependency
+    static Workload without_task(const Workload& workload, size_t removed) {
+        Workload result;
+        result.config = workload.config;
+        const auto& removed_task = workload.tasks[removed];
+
+        for (size_t i = 0; i < workload.tasks.size(); ++i) {
+            if (i == removed) continue;
+            auto task = workload.tasks[i];
+            if (!task.dependencies.empty() && task.dependencies.front() == removed_task.name) {
+                task.dependencies = removed_task.dependencies;
+            }
+            task.index = result.tasks.size();
+            result.tasks.push_back(task);
+        }
+        return result;
+    }
+
+    // Greedy shrinking: drop tasks, then simplify fields, until no step
+    // keeps the divergence
+    static Workload shrink(const Engine& reference, const Engine& candidate, Workload workload) {
+        bool progress = true;
+        while (progress) {
+            progress = false;
+
+            for (size_t i = workload.tasks.size(); i-- > 0;) {
+                auto smaller = without_task(workload, i);
+                if (diverges(reference, candidate, smaller)) {
+                    workload = std::move(smaller);
+                    progress = true;
+                }
+            }
+
+            for (size_t i = 0; i < workload.tasks.size(); ++i) {
+                for (int field = 0; field < 4; ++field) {
+                    auto simpler = workload;
+                    auto& task = simpler.tasks[i];
+                    int* value = field == 0 ? &task.initial_sleep_time
+                               : field == 1 ? &task.network_time
+                               : field == 2 ? &task.ram
+                               : &task.run_time;
+                    if (*value == 0) continue;
+                    *value /= 2;
+                    if (diverges(reference, candidate, simpler)) {
+                        workload = std::move(simpler);
+                        progress = true;
+                    }
+                }
+            }
+        }
+        return workload;
+    }
+
+    static std::string describe(const Workload& workload, const std::string& csv_path) {
+        parsers::write_tasks_csv(csv_path, workload.tasks);
+
+        std::ostringstream out;
+        out << "Minimal diverging workload written to " << csv_path << "\n";
+        for (const auto& [host_id, host_config] : workload.config.hosts) {
+            out << "  " << host_id << ": " << host_config.cpu_cores << " cores, "
+                << host_config.ram << " RAM\n";
+        }
+        std::ifstream csv(csv_path);
+        out << csv.rdbuf();
+        return out.str();
+    }
+
+    void expect_equivalent(const Engine& reference, const Engine& candidate,
+                           uint32_t num_seeds) {
+        for (uint32_t seed = 1; seed <= num_seeds; ++seed) {
+            auto workload = generate_workload(seed);
+            if (diverges(reference, candidate, workload)) {
+                auto minimal = shrink(reference, candidate, workload);
+                auto csv_path = (fs::path(::testing::TempDir()) /
+                                 ("differential_seed_" + std::to_string(seed) + ".csv")).string();
+                ADD_FAILURE() << "Seed " << seed << ": schedules differ\n" << describe(minimal, csv_path);
+                return;
+            }
+        }
+    }
+};
+
+TEST_F(DifferentialTest, GeneratedWorkloadsAreValid) {
+    for (uint32_t seed = 1; seed <= 50; ++seed) {
+        auto workload = generate_workload(seed);
+        EXPECT_NO_THROW(parsers::validate_task_dependencies(workload.tasks));
+        EXPECT_NO_THROW(workload.config.validate(true));
+    }
+}
+
+TEST_F(DifferentialTest, ReferenceIsDeterministic) {
+    expect_equivalent(run_reference, run_reference, 200);
+}
+
+TEST_F(DifferentialTest, InitPathMatchesReference) {
+    Engine candidate = [](const Workload& workload) {
+        auto tasks = workload.tasks;
+        simulator::TaskSimulator sim;
+        sim.init(workload.config, std::move(tasks));
+        sim.run();
+        return EngineResult{simulator::trace_digest(sim.tasks(), sim.records()), sim.records()};
+    };
+    expect_equivalent(run_reference, candidate, 200);
+}
+
+TEST_F(DifferentialTest, CoarseningMatchesReference) {
+    size_t coarsened = 0;
+    Engine candidate = [&coarsened](const Workload& workload) {
+        auto tasks = workload.tasks;
+        simulator::TaskSimulator sim(workload.config, std::move(tasks));
+        sim.enable_coarsening();
+        sim.run();
+        coarsened += sim.coarsened_tasks();
+        return EngineResult{simulator::trace_digest(sim.tasks(), sim.records()), sim.records()};
+    };
+    expect_equivalent(run_reference, candidate, 200);
+    EXPECT_GT(coarsened, 0u);
+}
+
+TEST_F(DifferentialTest, LinkClockMatchesReference) {
+    Engine candidate = [](const Workload& workload) {
+        auto config = workload.config;
+        config.link_model = models::LinkModel::Clock;
+        auto tasks = workload.tasks;
+        simulator::TaskSimulator sim(config, std::move(tasks));
+        sim.run();
+        return EngineResult{simulator::trace_digest(sim.tasks(), sim.records()), sim.records()};
+    };
+    expect_equivalent(run_reference, candidate, 1000);
+}
+
+TEST_F(DifferentialTest, LockstepReplicationsMatchReference) {
+    // Every replication, replayed or run after diverging, must equal a run
+    // of the engine with its straggler seed
+    size_t replayed = 0;
+    size_t total = 0;
+    for (uint32_t seed = 1; seed <= 200; ++seed) {
+        auto workload = generate_workload(seed);
+        workload.config.stragglers.probability = 0.3;
+        workload.config.stragglers.distribution = models::SlowdownDistribution::Uniform;
+        workload.config.stragglers.min = 1.5;
+        workload.config.stragglers.max = 4.0;
+        workload.config.stragglers.seed = seed;
+        if (seed % 2 == 0) {
+            workload.config.link_model = models::LinkModel::Clock;
+        }
+
+        auto replications = simulator::run_lockstep(workload.config, workload.tasks, 10);
+        ASSERT_EQ(replications.size(), 10u);
+        for (const auto& replication : replications) {
+            auto config = workload.config;
+            config.stragglers.seed = replication.seed;
+            auto expected = run_reference(Workload{config, workload.tasks});
+            ASSERT_EQ(simulator::trace_digest(workload.tasks, replication.records), expected.digest)
+                << "Seed " << seed << ", straggler seed " << replication.seed;
+            int64_t makespan = 0;
+            for (const auto& record : expected.records) {
+                makespan = std::max(makespan, record.finish);
+            }
+            ASSERT_EQ(replication.makespan, makespan);
+            replayed += replication.lockstep;
+            ++total;
+        }
+    }
+    // Lanes diverge where RAM blocks or stragglers reorder a host's queue
+    EXPECT_GT(replayed, total / 10);
+}
+
+TEST_F(DifferentialTest, ShrinkerIsolatesDivergingTask) {
+    // Broken candidate: delays every task that has an initial sleep
+    Engine candidate = [](const Workload& workload) {
+        auto tasks = workload.tasks;
+        simulator::TaskSimulator sim(workload.config, std::move(tasks));
+        sim.run();
+        auto records = sim.records();
+        for (size_t i = 0; i < records.size(); ++i) {
+            if (sim.tasks()[i].initial_sleep_time > 0) {
+                records[i].finish += 1;
+            }
+        }
+        return EngineResult{simulator::trace_digest(sim.tasks(), records), records};
+    };
+
+    for (uint32_t seed = 1; seed <= 50; ++seed) {
+        auto workload = generate_workload(seed);
+        if (!diverges(run_reference, candidate, workload)) continue;
+
+        auto minimal = shrink(run_reference, candidate, workload);
+        ASSERT_EQ(minimal.tasks.size(), 1u);
+        EXPECT_EQ(minimal.tasks[0].initial_sleep_time, 1);
+        EXPECT_EQ(minimal.tasks[0].run_time, 0);
+        EXPECT_TRUE(minimal.tasks[0].dependencies.empty());
+
+        auto csv_path = (fs::path(::testing::TempDir()) / "differential_shrink.csv").string();
+        describe(minimal, csv_path);
+        auto reparsed = parsers::parse_tasks_csv(csv_path);
+        EXPECT_EQ(reparsed.size(), 1u);
+        return;
+    }
+    FAIL() << "No generated workload exercised the broken candidate";
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,9 +1,27 @@
 #include <gtest/gtest.h>
+#include "../include/analysis.hpp"
+#include "../include/calibration.hpp"
 #include "../include/config_parser.h"
 #include "../include/csv_parser.h"
+#include "../include/decompress.h"
+#include "../include/executor.hpp"
 #include "../include/simulator.hpp"
+#include "../include/metrics.hpp"
+#include "../include/results.hpp"
+#include "../include/sampling.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <fstream>
 #include <filesystem>
+#include <csignal>
+#include <sstream>
+#include <numeric>
+#include <random>
+#include <thread>
+#ifdef TASK_SIMULATOR_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -445,6 +463,1428 @@ TEST_F(EdgeCaseTest, TaskWithZeroResources) {
     EXPECT_NO_THROW(sim.run());
 }
 
+// ============================================================================
+// Host Speed Factor Tests
+// ============================================================================
+
+TEST_F(EdgeCaseTest, HostSpeedScalesExecutionTime) {
+    write_file("config.xml",
+        "<?xml version=\"1.0\"?>\n"
+        "<experiments>\n"
+        "  <experiment name=\"test\">\n"
+        "    <tasks>" + test_dir + "/tasks.csv</tasks>\n"
+        "    <host id=\"HOST_0\"><cpu_cores>1</cpu_cores><ram>1000</ram><speed>2.0</speed></host>\n"
+        "  </experiment>\n"
+        "</experiments>\n"
+    );
+
+    write_file("tasks.csv",
+        "TASK_NAME,TASK_HOST,TASK_INITIAL_SLEEP_TIME,TASK_RUN_TIME,TASK_RAM,TASK_NETWORK_TIME,TASK_DEPENDENCY\n"
+        "Task1,HOST_0,0,100,100,0,\n"
+        "Task2,HOST_0,0,50,100,0,Task1\n"
+    );
+
+    auto experiments = parsers::load_experiments_from_xml(test_dir + "/config.xml");
+    auto experiment = parsers::get_experiment_config(experiments, "test");
+    auto tasks = parsers::parse_tasks_csv(test_dir + "/tasks.csv");
+
+    simulator::TaskSimulator sim(experiment, std::move(tasks));
+    sim.run();
+
+    // (100 + 50) / 2
+    EXPECT_EQ(sim.makespan(), 75);
+}
+
+TEST_F(EdgeCaseTest, ScalingClassOverridesHostSpeed) {
+    write_file("config.xml",
+        "<?xml version=\"1.0\"?>\n"
+        "<experiments>\n"
+        "  <experiment name=\"test\">\n"
+        "    <tasks>" + test_dir + "/tasks.csv</tasks>\n"
+        "    <host id=\"HOST_0\"><cpu_cores>1</cpu_cores><ram>1000</ram>"
+        "<speed>2.0</speed><speed class=\"io\">1.0</speed></host>\n"
+        "  </experiment>\n"
+        "</experiments>\n"
+    );
+
+    write_file("tasks.csv",
+        "TASK_NAME,TASK_HOST,TASK_INITIAL_SLEEP_TIME,TASK_RUN_TIME,TASK_RAM,TASK_NETWORK_TIME,TASK_DEPENDENCY,TASK_SCALING_CLASS\n"
+        "Task1,HOST_0,0,100,100,0,,io\n"
+        "Task2,HOST_0,0,100,100,0,Task1,\n"
+    );
+
+    auto experiments = parsers::load_experiments_from_xml(test_dir + "/config.xml");
+    auto experiment = parsers::get_experiment_config(experiments, "test");
+    auto tasks = parsers::parse_tasks_csv(test_dir + "/tasks.csv");
+    ASSERT_EQ(tasks[0].scaling_class, "io");
+
+    simulator::TaskSimulator sim(experiment, std::move(tasks));
+    sim.run();
+
+    // io task runs at speed 1 (100), default task at speed 2 (50)
+    EXPECT_EQ(sim.makespan(), 150);
+}
+
+TEST_F(EdgeCaseTest, NonPositiveHostSpeed) {
+    write_file("zero_speed.xml",
+        "<?xml version=\"1.0\"?>\n"
+        "<experiments>\n"
+        "  <experiment name=\"test\">\n"
+        "    <tasks>tasks.csv</tasks>\n"
+        "    <host id=\"HOST_0\"><cpu_cores>1</cpu_cores><ram>1000</ram><speed>0</speed></host>\n"
+        "  </experiment>\n"
+        "</experiments>\n"
+    );
+
+    EXPECT_THROW(
+        parsers::load_experiments_from_xml(test_dir + "/zero_speed.xml"),
+        std::invalid_argument
+    );
+}
+
+// ============================================================================
+// Live Instrumentation Tests
+// ============================================================================
+
+TEST_F(EdgeCaseTest, EngineCountersReachTotals) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+
+    std::vector<models::Task> tasks;
+    for (size_t i = 0; i < 5; ++i) {
+        tasks.push_back(models::Task{"T" + std::to_string(i), "HOST_0", 0, 10, 100, 0, {}, {}, i, 0});
+    }
+
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    sim.run();
+
+    auto snapshot = simulator::take_snapshot(sim.counters());
+    EXPECT_TRUE(snapshot.finished);
+    EXPECT_EQ(snapshot.tasks_completed, 5u);
+    EXPECT_EQ(snapshot.tasks_total, 5u);
+    EXPECT_EQ(snapshot.sim_time, 50);
+    EXPECT_GT(snapshot.events, 0u);
+}
+
+TEST_F(EdgeCaseTest, ProgressLineReportsRateAndEta) {
+    simulator::CountersSnapshot previous;
+    previous.tasks_total = 100;
+    simulator::CountersSnapshot current = previous;
+    current.taken_at = previous.taken_at + std::chrono::seconds(2);
+    current.events = 400;
+    current.tasks_completed = 20;
+
+    auto line = simulator::format_progress(previous, current);
+    EXPECT_NE(line.find("(200/s)"), std::string::npos) << line;
+    EXPECT_NE(line.find("20/100 (20.0%)"), std::string::npos) << line;
+    EXPECT_NE(line.find("ETA 8s"), std::string::npos) << line;
+}
+
+TEST_F(EdgeCaseTest, MetricsFileHasEngineAndHostGauges) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{2, 1000};
+
+    std::vector<models::Task> tasks;
+    tasks.push_back(models::Task{"T0", "HOST_0", 0, 10, 300, 0, {}, {}, 0, 0});
+
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    sim.run();
+
+    std::string path = test_dir + "/sim.prom";
+    simulator::MetricsExporter exporter(sim.counters(), path, std::chrono::hours(1));
+    exporter.write_now();
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+
+    EXPECT_NE(content.str().find("task_simulator_tasks_completed_total 1\n"), std::string::npos);
+    EXPECT_NE(content.str().find("task_simulator_host_cpu_busy{host=\"HOST_0\"} 0\n"), std::string::npos);
+    EXPECT_NE(content.str().find("task_simulator_host_ram_level{host=\"HOST_0\"} 1000\n"), std::string::npos);
+    EXPECT_NE(content.str().find("# TYPE task_simulator_events_total counter"), std::string::npos);
+    EXPECT_FALSE(fs::exists(path + ".tmp"));
+}
+
+TEST_F(EdgeCaseTest, StateDumpShowsStuckRamWaiter) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+
+    // T1 needs more RAM than the host has and never starts
+    std::vector<models::Task> tasks;
+    tasks.push_back(models::Task{"T0", "HOST_0", 0, 10, 100, 0, {}, {}, 0, 0});
+    tasks.push_back(models::Task{"T1", "HOST_0", 5, 10, 2000, 0, {}, {}, 1, 0});
+
+    simulator::install_state_dump_handler();
+    std::raise(SIGUSR1);
+
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    EXPECT_THROW(sim.run(), std::runtime_error);
+
+    auto dump = sim.state_dump();
+    EXPECT_NE(dump.find("State dump at t=10"), std::string::npos) << dump;
+    EXPECT_NE(dump.find("HOST_0: 1 waiting"), std::string::npos) << dump;
+    EXPECT_NE(dump.find("T1 on HOST_0: waiting for RAM since t=5"), std::string::npos) << dump;
+    EXPECT_NE(dump.find("1 pending"), std::string::npos) << dump;
+}
+
+TEST_F(EdgeCaseTest, TimeSeriesRecordsRamLevelChanges) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{2, 1000};
+
+    // T1 waits for T0's RAM and starts at t=10
+    std::vector<models::Task> tasks;
+    tasks.push_back(models::Task{"T0", "HOST_0", 0, 10, 800, 0, {}, {}, 0, 0});
+    tasks.push_back(models::Task{"T1", "HOST_0", 0, 5, 800, 0, {}, {}, 1, 0});
+
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    sim.enable_timeseries();
+    sim.run();
+
+    auto collect = [](const simulator::TimeSeriesData& data, simulator::SeriesKind kind) {
+        std::vector<std::pair<int64_t, int64_t>> samples;
+        for (size_t i = 0; i < data.sample_series.size(); ++i) {
+            if (data.kinds[data.sample_series[i]] == kind) {
+                samples.emplace_back(data.sample_time[i], data.sample_value[i]);
+            }
+        }
+        return samples;
+    };
+
+    std::string path = test_dir + "/levels.ts";
+    sim.write_timeseries(path, 1);
+    auto exact = simulator::read_timeseries(path);
+    ASSERT_EQ(exact.names[0], "HOST_0");
+
+    // The release/reacquire at t=10 falls on one sample and disappears
+    std::vector<std::pair<int64_t, int64_t>> expected_ram{{0, 200}, {15, 1000}};
+    EXPECT_EQ(collect(exact, simulator::SeriesKind::RamLevel), expected_ram);
+    std::vector<std::pair<int64_t, int64_t>> expected_waiting{{0, 1}, {10, 0}};
+    EXPECT_EQ(collect(exact, simulator::SeriesKind::RamWaiting), expected_waiting);
+
+    // Downsampled: the value in effect at t=0 and t=20
+    sim.write_timeseries(path, 20);
+    auto coarse = simulator::read_timeseries(path);
+    EXPECT_EQ(coarse.interval, 20);
+    std::vector<std::pair<int64_t, int64_t>> expected_coarse{{0, 200}, {20, 1000}};
+    EXPECT_EQ(collect(coarse, simulator::SeriesKind::RamLevel), expected_coarse);
+}
+
+// ============================================================================
+// Result Files and Comparison
+// ============================================================================
+
+// T0 and T1 share one core on HOST_0; T2 on HOST_1 waits for T1's output
+static models::ExperimentConfig comparison_config(int host0_cores) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{host0_cores, 1000};
+    config.hosts["HOST_1"] = models::HostConfig{1, 1000};
+    return config;
+}
+
+static std::vector<models::Task> comparison_tasks() {
+    std::vector<models::Task> tasks;
+    tasks.push_back(models::Task{"T0", "HOST_0", 0, 10, 0, 0, {}, {}, 0, 0});
+    tasks.push_back(models::Task{"T1", "HOST_0", 0, 5, 0, 3, {}, {}, 1, 0});
+    tasks.push_back(models::Task{"T2", "HOST_1", 0, 4, 0, 0, {"T1"}, {}, 2, 0});
+    return tasks;
+}
+
+TEST_F(EdgeCaseTest, CriticalPathFollowsResourceBlocker) {
+    simulator::TaskSimulator sim(comparison_config(1), comparison_tasks());
+    sim.run();
+    ASSERT_EQ(sim.makespan(), 22);
+
+    // T2 (4) <- transfer (3) <- T1 (5) <- core held by T0 (10)
+    std::vector<bool> on_path;
+    auto composition = simulator::critical_path(sim.tasks(), sim.records(), on_path);
+    EXPECT_EQ(composition.run, 19);
+    EXPECT_EQ(composition.network, 3);
+    EXPECT_EQ(composition.wait, 0);
+    EXPECT_EQ(composition.sleep, 0);
+    EXPECT_EQ(on_path, (std::vector<bool>{true, true, true}));
+}
+
+TEST_F(EdgeCaseTest, CompareReportsMovedTasksAndCriticalPath) {
+    std::string baseline = test_dir + "/one_core.result";
+    std::string candidate = test_dir + "/two_cores.result";
+    {
+        simulator::TaskSimulator sim(comparison_config(1), comparison_tasks());
+        sim.run();
+        simulator::write_result_file(baseline, sim);
+    }
+    {
+        simulator::TaskSimulator sim(comparison_config(2), comparison_tasks());
+        sim.run();
+        simulator::write_result_file(candidate, sim);
+    }
+
+    auto comparison = simulator::compare_result_files(baseline, candidate, 1);
+    EXPECT_EQ(comparison.makespan_a, 22);
+    EXPECT_EQ(comparison.makespan_b, 12);
+    EXPECT_EQ(comparison.matched_tasks, 3u);
+    EXPECT_EQ(comparison.only_in_a + comparison.only_in_b, 0u);
+
+    ASSERT_EQ(comparison.hosts.size(), 2u);
+    EXPECT_EQ(comparison.hosts[0].name, "HOST_0");
+    EXPECT_NEAR(comparison.hosts[0].utilization_a, 100.0 * 15 / 22, 1e-3);
+    EXPECT_NEAR(comparison.hosts[0].utilization_b, 100.0 * 15 / 24, 1e-3);
+
+    // T1 and T2 both moved by 10; ties keep the first in name order
+    ASSERT_EQ(comparison.largest_moves.size(), 1u);
+    EXPECT_EQ(comparison.largest_moves[0].delta(), -10);
+
+    // T0 no longer delays T1
+    EXPECT_EQ(comparison.critical_b.run, 9);
+    EXPECT_EQ(comparison.critical_b.network, 3);
+    EXPECT_EQ(comparison.left_critical_path, 1u);
+    EXPECT_EQ(comparison.left_critical_examples, std::vector<std::string>{"T0"});
+    EXPECT_EQ(comparison.joined_critical_path, 0u);
+
+    auto report = simulator::format_comparison(comparison);
+    EXPECT_NE(report.find("Makespan:               22 -> 12 (-10, -45.45%)"), std::string::npos) << report;
+    EXPECT_NE(report.find("Left critical path: 1 (T0)"), std::string::npos) << report;
+}
+
+TEST_F(EdgeCaseTest, CompareMergesUnmatchedAndRejectsUnsortedRows) {
+    auto write = [this](const std::string& name, const std::string& rows) {
+        std::string path = test_dir + "/" + name;
+        std::ofstream file(path);
+        file << "# task_simulator result v1\nMAKESPAN,10\nCRITICAL_PATH,10,0,0,0\n"
+             << "TASK_NAME,TASK_HOST,READY,START,FINISH,CRITICAL\n" << rows;
+        return path;
+    };
+    auto a = write("a.result", "A,H,0,0,5,0\nB,H,0,5,10,1\nD,H,0,0,1,0\n");
+    auto b = write("b.result", "B,H,0,0,4,1\nC,H,0,0,6,0\nD,H,0,0,1,0\nE,H,0,0,2,0\n");
+
+    auto comparison = simulator::compare_result_files(a, b);
+    EXPECT_EQ(comparison.matched_tasks, 2u);
+    EXPECT_EQ(comparison.only_in_a, 1u);
+    EXPECT_EQ(comparison.only_in_b, 2u);
+    ASSERT_EQ(comparison.largest_moves.size(), 1u);
+    EXPECT_EQ(comparison.largest_moves[0].name, "B");
+
+    auto unsorted = write("unsorted.result", "B,H,0,0,4,0\nA,H,0,0,6,0\n");
+    EXPECT_THROW(simulator::compare_result_files(a, unsorted), std::runtime_error);
+}
+
+// ============================================================================
+// Approximate Time Quantum
+// ============================================================================
+
+TEST_F(EdgeCaseTest, QuantumRoundsWaits) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+
+    // Chain of three tasks: 7 + 3 + 5 = 15 exactly
+    auto make_tasks = [] {
+        std::vector<models::Task> tasks;
+        tasks.push_back(models::Task{"T0", "HOST_0", 0, 7, 0, 0, {}, {}, 0, 0});
+        tasks.push_back(models::Task{"T1", "HOST_0", 0, 3, 0, 0, {"T0"}, {}, 1, 0});
+        tasks.push_back(models::Task{"T2", "HOST_0", 0, 5, 0, 0, {"T1"}, {}, 2, 0});
+        return tasks;
+    };
+
+    simulator::TaskSimulator exact(config, make_tasks());
+    exact.run();
+    ASSERT_EQ(exact.makespan(), 15);
+
+    // Wake-ups at 5 (7), 10 (10) and 15 (15): T1 inherits T0's exact finish
+    simulator::TaskSimulator approx(config, make_tasks());
+    approx.set_quantum(5);
+    approx.run();
+    EXPECT_EQ(approx.records()[0].finish, 5);
+    EXPECT_EQ(approx.records()[1].start, 5);
+    EXPECT_EQ(approx.records()[1].finish, 10);
+    EXPECT_EQ(approx.makespan(), 15);
+
+    // Rounding errors do not accumulate along a long chain of short tasks
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+    std::vector<models::Task> chain;
+    for (size_t i = 0; i < 100; ++i) {
+        std::vector<std::string> deps;
+        if (i > 0) deps.push_back("T" + std::to_string(i - 1));
+        chain.push_back(models::Task{"T" + std::to_string(i), "HOST_0", 0, 3, 0, 0, deps, {}, i, 0});
+    }
+    simulator::TaskSimulator long_chain(config, std::move(chain));
+    long_chain.set_quantum(10);
+    long_chain.run();
+    EXPECT_EQ(long_chain.makespan(), 300);
+
+    simulator::TaskSimulator invalid(config, make_tasks());
+    EXPECT_THROW(invalid.set_quantum(0), std::invalid_argument);
+}
+
+TEST_F(EdgeCaseTest, QuantumSharesTickEvents) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1000, 100000};
+
+    // 1000 independent tasks with distinct run times 1..1000
+    auto make_tasks = [] {
+        std::vector<models::Task> tasks;
+        for (size_t i = 0; i < 1000; ++i) {
+            tasks.push_back(models::Task{"T" + std::to_string(i), "HOST_0", 0,
+                                         static_cast<int>(i + 1), 1, 0, {}, {}, i, 0});
+        }
+        return tasks;
+    };
+
+    simulator::TaskSimulator exact(config, make_tasks());
+    exact.run();
+
+    simulator::TaskSimulator approx(config, make_tasks());
+    approx.set_quantum(100);
+    approx.run();
+
+    EXPECT_EQ(approx.makespan(), exact.makespan());
+    EXPECT_LT(approx.counters().events.load(), exact.counters().events.load());
+    for (size_t i = 0; i < 1000; ++i) {
+        EXPECT_EQ(approx.records()[i].finish % 100, 0);
+        EXPECT_LE(std::abs(approx.records()[i].finish - exact.records()[i].finish), 50);
+    }
+}
+
+// ============================================================================
+// Compressed Task Input
+// ============================================================================
+
+TEST_F(EdgeCaseTest, ParseTasksFromStream) {
+    std::istringstream csv(
+        "TASK_NAME,TASK_HOST,TASK_INITIAL_SLEEP_TIME,TASK_RUN_TIME,TASK_RAM,TASK_NETWORK_TIME,TASK_DEPENDENCY\n"
+        "T0,HOST_0,0,5,100,0,\n"
+        "T1,HOST_0,0,5,100,0,T0\n");
+    auto tasks = parsers::parse_tasks_csv(csv);
+    ASSERT_EQ(tasks.size(), 2u);
+    EXPECT_EQ(tasks[1].dependencies, std::vector<std::string>{"T0"});
+}
+
+TEST_F(EdgeCaseTest, DetectCompressionByMagicBytes) {
+    write_file("plain.csv", "TASK_NAME\n");
+    write_file("short.csv", "\x1f");
+    write_file("fake.zst", std::string("\x28\xb5\x2f\xfd", 4) + "not a frame");
+
+    EXPECT_EQ(parsers::detect_compression(test_dir + "/plain.csv"), parsers::Compression::None);
+    EXPECT_EQ(parsers::detect_compression(test_dir + "/short.csv"), parsers::Compression::None);
+    EXPECT_EQ(parsers::detect_compression(test_dir + "/fake.zst"), parsers::Compression::Zstd);
+
+    // Corrupt, or unsupported in this build: either way an error, not garbage tasks
+    EXPECT_THROW(parsers::parse_tasks_csv(test_dir + "/fake.zst"), std::runtime_error);
+}
+
+#ifdef TASK_SIMULATOR_HAVE_ZLIB
+// Write `content` as gzip, split into `members` concatenated gzip members
+static void write_gzip(const std::string& path, const std::string& content, size_t members = 1) {
+    fs::remove(path);
+    size_t step = content.size() / members + 1;
+    for (size_t offset = 0; offset < content.size(); offset += step) {
+        gzFile file = gzopen(path.c_str(), "ab");
+        ASSERT_NE(file, nullptr);
+        size_t size = std::min(step, content.size() - offset);
+        ASSERT_EQ(gzwrite(file, content.data() + offset, static_cast<unsigned>(size)), static_cast<int>(size));
+        gzclose(file);
+    }
+}
+
+TEST_F(EdgeCaseTest, GzipCsvMatchesPlainCsv) {
+    // Large enough to span several decompressed chunks
+    std::vector<models::Task> tasks;
+    for (size_t i = 0; i < 100000; ++i) {
+        std::vector<std::string> deps;
+        if (i > 0) deps.push_back("Task_" + std::to_string(i - 1));
+        tasks.push_back(models::Task{"Task_" + std::to_string(i), "HOST_" + std::to_string(i % 7),
+                                     static_cast<int>(i % 3), static_cast<int>(i % 100), 10, 1,
+                                     deps, {}, i, 0});
+    }
+    std::string plain_path = test_dir + "/tasks.csv";
+    parsers::write_tasks_csv(plain_path, tasks);
+    std::ifstream plain_file(plain_path);
+    std::string content((std::istreambuf_iterator<char>(plain_file)), std::istreambuf_iterator<char>());
+
+    std::string gz_path = test_dir + "/tasks.csv.gz";
+    write_gzip(gz_path, content, 3);
+    ASSERT_EQ(parsers::detect_compression(gz_path), parsers::Compression::Gzip);
+
+    auto plain = parsers::parse_tasks_csv(plain_path);
+    auto decompressed = parsers::parse_tasks_csv(gz_path);
+    ASSERT_EQ(decompressed.size(), plain.size());
+    for (size_t i = 0; i < plain.size(); ++i) {
+        EXPECT_EQ(decompressed[i].name, plain[i].name);
+        EXPECT_EQ(decompressed[i].run_time, plain[i].run_time);
+        EXPECT_EQ(decompressed[i].dependencies, plain[i].dependencies);
+    }
+}
+
+TEST_F(EdgeCaseTest, TruncatedGzipCsvThrows) {
+    std::string content =
+        "TASK_NAME,TASK_HOST,TASK_INITIAL_SLEEP_TIME,TASK_RUN_TIME,TASK_RAM,TASK_NETWORK_TIME,TASK_DEPENDENCY\n";
+    for (int i = 0; i < 1000; ++i) {
+        content += "T" + std::to_string(i) + ",HOST_0,0,5,100,0,\n";
+    }
+    std::string gz_path = test_dir + "/truncated.csv.gz";
+    write_gzip(gz_path, content);
+    fs::resize_file(gz_path, fs::file_size(gz_path) / 2);
+
+    try {
+        parsers::parse_tasks_csv(gz_path);
+        FAIL() << "Expected truncated gzip input to be rejected";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("gzip"), std::string::npos) << e.what();
+    }
+}
+#endif
+
+// ============================================================================
+// Per-Task Result Rows
+// ============================================================================
+
+TEST_F(EdgeCaseTest, TaskRowsRecordWaits) {
+    std::string csv_path = test_dir + "/rows.csv";
+    std::string columnar_path = test_dir + "/rows.bin";
+    for (auto [path, format] : {std::pair{csv_path, simulator::TaskRowFormat::Csv},
+                                std::pair{columnar_path, simulator::TaskRowFormat::Columnar}}) {
+        simulator::TaskSimulator sim(comparison_config(1), comparison_tasks());
+        sim.enable_task_rows(path, format);
+        sim.run();
+    }
+
+    // Rows in finish order; T1 waits for T0's core, T2 for T1 and its output
+    std::ifstream csv(csv_path);
+    std::string content((std::istreambuf_iterator<char>(csv)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content,
+              "TASK_NAME,TASK_HOST,READY,START,FINISH,DEPENDENCY_WAIT,LINK_WAIT,TRANSFER,RAM_WAIT,CPU_WAIT\n"
+              "T0,HOST_0,0,0,10,0,0,0,0,0\n"
+              "T1,HOST_0,0,10,15,0,0,0,0,10\n"
+              "T2,HOST_1,18,18,22,15,0,3,0,0\n");
+
+    auto data = simulator::read_task_rows(columnar_path);
+    EXPECT_EQ(data.task_names, (std::vector<std::string>{"T0", "T1", "T2"}));
+    ASSERT_EQ(data.task, (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_EQ(data.host_names[data.host[2]], "HOST_1");
+    EXPECT_EQ(data.finish, (std::vector<int64_t>{10, 15, 22}));
+    EXPECT_EQ(data.cpu_wait, (std::vector<int64_t>{0, 10, 0}));
+    EXPECT_EQ(data.dependency_wait[2], 15);
+    EXPECT_EQ(data.transfer[2], 3);
+}
+
+TEST_F(EdgeCaseTest, TaskRowSinkSpansBuffers) {
+    std::vector<std::string> task_names;
+    for (int i = 0; i < 10; ++i) task_names.push_back("T" + std::to_string(i));
+    std::vector<std::string> host_names{"HOST_0"};
+    std::string path = test_dir + "/rows.bin";
+
+    // Buffers of 3 rows: 3 full hand-offs and a partial one on close
+    simulator::TaskRowSink sink(path, simulator::TaskRowFormat::Columnar, task_names, host_names, 3);
+    for (uint32_t i = 0; i < 10; ++i) {
+        int64_t t = i;
+        sink.push(simulator::TaskRow{9 - i, 0, t, t, t + 1, 0, 0, 0, 0, i});
+    }
+    sink.close();
+    EXPECT_EQ(sink.rows(), 10u);
+
+    auto data = simulator::read_task_rows(path);
+    ASSERT_EQ(data.task.size(), 10u);
+    for (uint32_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(data.task[i], 9 - i);
+        EXPECT_EQ(data.finish[i], i + 1);
+        EXPECT_EQ(data.cpu_wait[i], i);
+    }
+
+    // Missing end marker
+    fs::resize_file(path, fs::file_size(path) - sizeof(uint32_t));
+    EXPECT_THROW(simulator::read_task_rows(path), std::runtime_error);
+}
+
+TEST_F(EdgeCaseTest, AnalyzeTaskRowsAggregatesColumns) {
+    simulator::TaskRowData data;
+    data.host_names = {"H0", "H1"};
+    data.task_names = {"A", "B", "C"};
+    data.task = {0, 1, 2};
+    data.host = {0, 0, 1};
+    data.ready = {0, 0, 3};
+    data.start = {0, 5, 10};
+    data.finish = {10, 25, 12};
+    data.dependency_wait = {0, 0, 3};
+    data.link_wait = {0, 0, 0};
+    data.transfer = {0, 0, 0};
+    data.ram_wait = {0, 0, 7};
+    data.cpu_wait = {0, 5, 0};
+
+    simulator::WorkStealingPool pool(2);
+    auto analysis = simulator::analyze_task_rows(data, 3, pool);
+    EXPECT_EQ(analysis.rows, 3u);
+    EXPECT_EQ(analysis.makespan, 25);
+
+    // Windows of 9: A covers [0, 10), B [5, 25)
+    EXPECT_EQ(analysis.window, 9);
+    ASSERT_EQ(analysis.hosts.size(), 2u);
+    EXPECT_EQ(analysis.hosts[0].window_busy, (std::vector<int64_t>{13, 10, 7}));
+    EXPECT_EQ(analysis.hosts[1].window_busy, (std::vector<int64_t>{0, 2, 0}));
+    EXPECT_EQ(analysis.hosts[0].busy, 30);
+    EXPECT_EQ(analysis.hosts[0].tasks, 2u);
+
+    // Nearest rank over {0, 5} and {10, 25}
+    EXPECT_EQ(analysis.hosts[0].queue.p50, 0);
+    EXPECT_EQ(analysis.hosts[0].queue.p90, 5);
+    EXPECT_EQ(analysis.hosts[0].response.p50, 10);
+    EXPECT_EQ(analysis.hosts[0].response.max, 25);
+    EXPECT_EQ(analysis.hosts[1].queue.p99, 7);
+
+    const auto& cpu = analysis.waits[4];
+    EXPECT_EQ(cpu.name, "cpu");
+    EXPECT_EQ(cpu.buckets[0], 2u);
+    EXPECT_EQ(cpu.buckets[3], 1u);
+    EXPECT_EQ(cpu.total, 5);
+    auto report = simulator::format_analysis(analysis);
+    EXPECT_NE(report.find("0:2 4-7:1"), std::string::npos) << report;
+
+    EXPECT_THROW(simulator::analyze_task_rows(data, 0, pool), std::invalid_argument);
+}
+
+TEST_F(EdgeCaseTest, AnalyzeTaskRowsMatchesNaiveScanAcrossBlocks) {
+    // Enough rows for several blocks on every worker
+    std::mt19937 rng(5);
+    auto uniform = [&rng](int64_t lo, int64_t hi) {
+        return std::uniform_int_distribution<int64_t>(lo, hi)(rng);
+    };
+    simulator::TaskRowData data;
+    data.host_names = {"H0", "H1", "H2"};
+    size_t rows = 300000;
+    for (auto* column : {&data.ready, &data.start, &data.finish, &data.dependency_wait, &data.link_wait,
+                         &data.transfer, &data.ram_wait, &data.cpu_wait}) {
+        column->resize(rows);
+    }
+    data.host.resize(rows);
+    data.task.resize(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        data.task[i] = static_cast<uint32_t>(i);
+        data.host[i] = static_cast<uint32_t>(uniform(0, 2));
+        data.ready[i] = uniform(0, 100000);
+        data.start[i] = data.ready[i] + uniform(0, 50);
+        data.finish[i] = data.start[i] + uniform(0, 3000);
+        data.cpu_wait[i] = uniform(0, 1 << 20);
+    }
+
+    simulator::WorkStealingPool pool(3);
+    auto analysis = simulator::analyze_task_rows(data, 7, pool);
+
+    int64_t makespan = *std::max_element(data.finish.begin(), data.finish.end());
+    EXPECT_EQ(analysis.makespan, makespan);
+    int64_t width = analysis.window;
+    std::vector<std::vector<int64_t>> busy(3, std::vector<int64_t>(analysis.hosts[0].window_busy.size()));
+    std::vector<std::vector<int64_t>> response(3);
+    std::array<uint64_t, 65> buckets{};
+    for (size_t i = 0; i < rows; ++i) {
+        for (int64_t t = data.start[i] / width * width; t < data.finish[i]; t += width) {
+            busy[data.host[i]][t / width] += std::min(data.finish[i], t + width) - std::max(data.start[i], t);
+        }
+        response[data.host[i]].push_back(data.finish[i] - data.ready[i]);
+        ++buckets[std::bit_width(static_cast<uint64_t>(data.cpu_wait[i]))];
+    }
+    EXPECT_EQ(analysis.waits[4].buckets, buckets);
+    for (size_t h = 0; h < 3; ++h) {
+        EXPECT_EQ(analysis.hosts[h].window_busy, busy[h]) << h;
+        auto& values = response[h];
+        std::sort(values.begin(), values.end());
+        EXPECT_EQ(analysis.hosts[h].tasks, values.size());
+        EXPECT_EQ(analysis.hosts[h].response.p50, values[(values.size() + 1) / 2 - 1]);
+        EXPECT_EQ(analysis.hosts[h].response.p99, values[(values.size() * 99 + 99) / 100 - 1]);
+        EXPECT_EQ(analysis.hosts[h].response.max, values.back());
+    }
+}
+
+// ============================================================================
+// Stragglers and Speculative Execution
+// ============================================================================
+
+// Nearly every execution is slowed 5x and speculation starts at 1x the
+// expected time (the 0.05th percentile lies below the straggler mass)
+static models::ExperimentConfig straggler_config(double backup_speed) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{2, 1000};
+    config.hosts["HOST_1"] = models::HostConfig{1, 1000, backup_speed};
+    config.stragglers.probability = 0.999;
+    config.stragglers.min = 5.0;
+    config.speculation.enabled = true;
+    config.speculation.percentile = 0.05;
+    return config;
+}
+
+TEST_F(EdgeCaseTest, StragglersAreSeededAndParsed) {
+    write_file("tasks.csv", "TASK_NAME,TASK_HOST,TASK_INITIAL_SLEEP_TIME,TASK_RUN_TIME,TASK_RAM,TASK_NETWORK_TIME,TASK_DEPENDENCY\n");
+    write_file("config.xml", R"(<?xml version="1.0"?>
+<experiments>
+    <experiment name="tail">
+        <tasks>tasks.csv</tasks>
+        <host id="HOST_0"><cpu_cores>1000</cpu_cores><ram>100000</ram></host>
+        <stragglers probability="0.3" seed="7" slowdown="uniform" min="2" max="4"/>
+    </experiment>
+</experiments>)");
+    auto config = parsers::get_experiment_config(
+        parsers::load_experiments_from_xml(test_dir + "/config.xml"), "tail");
+    EXPECT_EQ(config.stragglers.seed, 7u);
+    EXPECT_EQ(config.stragglers.distribution, models::SlowdownDistribution::Uniform);
+    EXPECT_FALSE(config.speculation.enabled);
+
+    write_file("bad.xml", R"(<?xml version="1.0"?>
+<experiments>
+    <experiment name="tail">
+        <tasks>tasks.csv</tasks>
+        <host id="HOST_0"><cpu_cores>1</cpu_cores><ram>100</ram></host>
+        <stragglers probability="0.3" seed="seven"/>
+    </experiment>
+</experiments>)");
+    try {
+        parsers::load_experiments_from_xml(test_dir + "/bad.xml");
+        FAIL() << "seed=\"seven\" was accepted";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("stragglers seed 'seven' in experiment 'tail'"), std::string::npos)
+            << e.what();
+    }
+
+    auto make_tasks = [] {
+        std::vector<models::Task> tasks;
+        for (size_t i = 0; i < 1000; ++i) {
+            tasks.push_back(models::Task{"T" + std::to_string(i), "HOST_0", 0, 100, 1, 0, {}, {}, i, 0});
+        }
+        return tasks;
+    };
+    simulator::TaskSimulator first(config, make_tasks());
+    simulator::TaskSimulator second(config, make_tasks());
+    EXPECT_EQ(first.stragglers()->exec_time, second.stragglers()->exec_time);
+    EXPECT_GT(first.stragglers()->stragglers, 250u);
+    EXPECT_LT(first.stragglers()->stragglers, 350u);
+    for (int64_t exec_time : first.stragglers()->exec_time) {
+        EXPECT_TRUE(exec_time == 100 || (exec_time >= 200 && exec_time <= 400)) << exec_time;
+    }
+
+    first.run();
+    int64_t slowest = *std::max_element(first.stragglers()->exec_time.begin(),
+                                        first.stragglers()->exec_time.end());
+    EXPECT_EQ(first.makespan(), slowest);
+
+    config.stragglers.seed = 8;
+    simulator::TaskSimulator reseeded(config, make_tasks());
+    EXPECT_NE(reseeded.stragglers()->exec_time, first.stragglers()->exec_time);
+    EXPECT_THROW(reseeded.set_quantum(10), std::invalid_argument);
+}
+
+TEST_F(EdgeCaseTest, BackupCopyWinsAndCancelsStraggler) {
+    std::vector<models::Task> tasks;
+    tasks.push_back(models::Task{"T0", "HOST_0", 0, 10, 100, 0, {}, {}, 0, 0});
+    tasks.push_back(models::Task{"T1", "HOST_0", 0, 0, 100, 0, {"T0"}, {}, 1, 0});
+    simulator::TaskSimulator sim(straggler_config(1.0), std::move(tasks));
+    ASSERT_EQ(sim.stragglers()->exec_time[0], 50);
+    sim.run();
+
+    // The backup starts on HOST_1 at 10 and finishes at 20, well before 50
+    EXPECT_EQ(sim.records()[0].finish, 20);
+    EXPECT_EQ(sim.records()[1].start, 20);
+    EXPECT_EQ(sim.makespan(), 20);
+    const auto& stats = *sim.stragglers();
+    EXPECT_EQ(stats.backups, 1u);
+    EXPECT_EQ(stats.backups_won, 1u);
+    EXPECT_EQ(stats.cancelled, 1u);
+    EXPECT_EQ(stats.wasted_time, 20);
+}
+
+TEST_F(EdgeCaseTest, StragglerWinsAndCancelsQueuedAndRunningBackups) {
+    std::vector<models::Task> tasks;
+    tasks.push_back(models::Task{"T0", "HOST_0", 0, 10, 100, 0, {}, {}, 0, 0});
+    tasks.push_back(models::Task{"T1", "HOST_0", 0, 10, 100, 0, {}, {}, 1, 0});
+    simulator::TaskSimulator sim(straggler_config(0.1), std::move(tasks));
+    ASSERT_EQ(sim.stragglers()->exec_time, (std::vector<int64_t>{50, 50}));
+    sim.run();
+
+    // Both backups go to HOST_1's single slow core: one runs 10..50, the
+    // other is still queued for the core when the originals finish at 50
+    EXPECT_EQ(sim.records()[0].finish, 50);
+    EXPECT_EQ(sim.records()[1].finish, 50);
+    EXPECT_EQ(sim.makespan(), 50);
+    const auto& stats = *sim.stragglers();
+    EXPECT_EQ(stats.backups, 2u);
+    EXPECT_EQ(stats.backups_won, 0u);
+    EXPECT_EQ(stats.cancelled, 2u);
+    EXPECT_EQ(stats.wasted_time, 40);
+
+    const auto& backup_host = **std::find_if(sim.hosts().begin(), sim.hosts().end(),
+                                             [](const auto& host) { return host->name == "HOST_1"; });
+    EXPECT_EQ(backup_host.cpu.available(), 1u);
+    EXPECT_EQ(backup_host.ram.level(), 1000u);
+}
+
+// ============================================================================
+// Dominant Resource Fairness
+// ============================================================================
+
+// Group A: 8 small tasks (dominant resource CPU); group B: 4 tasks holding
+// 40% of the RAM each. A's tasks come first in the file.
+static std::vector<models::Task> drf_tasks() {
+    std::vector<models::Task> tasks;
+    for (size_t i = 0; i < 12; ++i) {
+        bool a = i < 8;
+        tasks.push_back(models::Task{(a ? "A" : "B") + std::to_string(i), "HOST_0", 0, 10, a ? 10 : 400, 0,
+                                     {}, {}, i, 0, "", a ? "A" : "B"});
+    }
+    return tasks;
+}
+
+TEST_F(EdgeCaseTest, DrfAdmitsLowestDominantShareGroup) {
+    std::string csv_path = test_dir + "/groups.csv";
+    parsers::write_tasks_csv(csv_path, drf_tasks());
+    auto tasks = parsers::parse_tasks_csv(csv_path);
+    EXPECT_EQ(tasks[0].group, "A");
+    EXPECT_EQ(tasks[11].group, "B");
+
+    write_file("config.xml", R"(<?xml version="1.0"?>
+<experiments>
+    <experiment name="shared">
+        <tasks>groups.csv</tasks>
+        <host id="HOST_0"><cpu_cores>4</cpu_cores><ram>1000</ram></host>
+        <admission policy="drf"/>
+    </experiment>
+</experiments>)");
+    auto drf_config = parsers::get_experiment_config(
+        parsers::load_experiments_from_xml(test_dir + "/config.xml"), "shared");
+    ASSERT_EQ(drf_config.admission, models::AdmissionPolicy::Drf);
+    auto fifo_config = drf_config;
+    fifo_config.admission = models::AdmissionPolicy::Fifo;
+
+    // FIFO: B waits for all of A's tasks
+    simulator::TaskSimulator fifo(fifo_config, std::move(tasks));
+    fifo.run();
+    EXPECT_EQ(fifo.records()[8].start, 20);
+
+    // DRF: once A holds cores, B's zero share wins the first freed core and
+    // A's share must drop below B's before A gets the next ones
+    simulator::TaskSimulator drf(drf_config, drf_tasks());
+    drf.run();
+    EXPECT_EQ(drf.records()[8].start, 10);
+    EXPECT_EQ(drf.records()[9].start, 10);
+    EXPECT_EQ(drf.records()[4].start, 10);
+
+    auto fifo_groups = fifo.group_stats();
+    auto drf_groups = drf.group_stats();
+    ASSERT_EQ(drf_groups.size(), 2u);
+    EXPECT_EQ(drf_groups[0].name, "A");
+    EXPECT_EQ(drf_groups[0].tasks, 8u);
+    EXPECT_EQ(drf_groups[1].tasks, 4u);
+    EXPECT_LT(drf_groups[1].mean_slowdown, fifo_groups[1].mean_slowdown);
+    EXPECT_DOUBLE_EQ(drf_groups[1].throughput, 4.0 / static_cast<double>(drf.makespan()));
+
+    // Every core and RAM unit is back
+    EXPECT_EQ(drf.hosts()[0]->cpu.available(), 4u);
+    EXPECT_EQ(drf.hosts()[0]->ram.level(), 1000u);
+
+    // Backup copies would bypass the DRF queue
+    auto speculative = drf_config;
+    speculative.speculation.enabled = true;
+    EXPECT_THROW(simulator::TaskSimulator(speculative, drf_tasks()), std::invalid_argument);
+}
+
+TEST_F(EdgeCaseTest, RunFailsWhenTasksNeverComplete) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 100};
+
+    // B never gets its RAM, so C never becomes ready
+    std::vector<models::Task> tasks{
+        {"A", "HOST_0", 0, 10, 50, 0, {}, {}, 0, 0},
+        {"B", "HOST_0", 0, 10, 200, 0, {}, {}, 1, 0},
+        {"C", "HOST_0", 0, 10, 50, 0, {"B"}, {}, 2, 0},
+    };
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    try {
+        sim.run();
+        FAIL() << "Expected the stalled run to throw";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("2 of 3 tasks never completed"), std::string::npos) << e.what();
+    }
+}
+
+// ============================================================================
+// Work-Stealing Pool
+// ============================================================================
+
+TEST_F(EdgeCaseTest, PoolReturnsResultsInIndexOrder) {
+    simulator::WorkStealingPool pool(4);
+    // Early jobs take longest, so they finish last
+    auto results = pool.map<size_t>(32, [](size_t i) {
+        std::this_thread::sleep_for(std::chrono::microseconds((32 - i) * 100));
+        return i * i;
+    });
+    ASSERT_EQ(results.size(), 32u);
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i], i * i);
+    }
+
+    uint64_t jobs = 0;
+    for (const auto& worker : pool.stats()) {
+        jobs += worker.jobs;
+    }
+    EXPECT_EQ(jobs, 32u);
+}
+
+TEST_F(EdgeCaseTest, PoolRunsNestedMapsWithoutDeadlock) {
+    // Every worker blocks in an inner map; only helping while waiting lets
+    // the inner jobs run
+    simulator::WorkStealingPool pool(2);
+    auto sums = pool.map<size_t>(8, [&pool](size_t i) {
+        auto parts = pool.map<size_t>(16, [i](size_t j) { return i * 100 + j; });
+        return std::accumulate(parts.begin(), parts.end(), size_t{0});
+    });
+    for (size_t i = 0; i < sums.size(); ++i) {
+        EXPECT_EQ(sums[i], i * 1600 + 120);
+    }
+}
+
+TEST_F(EdgeCaseTest, PoolRethrowsLowestIndexErrorAfterAllJobs) {
+    simulator::WorkStealingPool pool(3);
+    std::atomic<size_t> ran{0};
+    try {
+        pool.map<int>(20, [&ran](size_t i) -> int {
+            ++ran;
+            if (i == 7 || i == 13) {
+                throw std::runtime_error("job " + std::to_string(i));
+            }
+            return 0;
+        });
+        FAIL() << "Expected an exception";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "job 7");
+    }
+    EXPECT_EQ(ran.load(), 20u);
+}
+
+// ============================================================================
+// Autoscaling
+// ============================================================================
+
+TEST_F(EdgeCaseTest, AutoscalerAddsAndDrainsPoolHosts) {
+    std::vector<models::Task> tasks;
+    for (size_t i = 0; i < 12; ++i) {
+        tasks.push_back(models::Task{"T" + std::to_string(i), "POOL", 0, 100, 100, 0, {}, {}, i, 0});
+    }
+    parsers::write_tasks_csv(test_dir + "/pool.csv", tasks);
+    write_file("config.xml", R"(<?xml version="1.0"?>
+<experiments>
+    <experiment name="elastic">
+        <tasks>pool.csv</tasks>
+        <autoscaling min="1" max="3" interval="10" provisioning_delay="5"
+                     scale_up_queue="1" scale_down_utilization="0.5">
+            <cpu_cores>2</cpu_cores>
+            <ram>1000</ram>
+        </autoscaling>
+    </experiment>
+</experiments>)");
+    auto config = parsers::get_experiment_config(
+        parsers::load_experiments_from_xml(test_dir + "/config.xml"), "elastic");
+    ASSERT_TRUE(config.autoscaling.enabled);
+    EXPECT_EQ(config.autoscaling.pool, "POOL");
+    EXPECT_EQ(config.autoscaling.initial_hosts, 1u);
+    EXPECT_EQ(config.autoscaling.host.cpu_cores, 2);
+
+    parsers::write_experiments_xml(test_dir + "/written.xml", {{"elastic", config}});
+    auto written = parsers::get_experiment_config(
+        parsers::load_experiments_from_xml(test_dir + "/written.xml"), "elastic");
+    EXPECT_EQ(written.autoscaling.max_hosts, 3u);
+    EXPECT_EQ(written.autoscaling.provisioning_delay, 5);
+    EXPECT_DOUBLE_EQ(written.autoscaling.scale_down_utilization, 0.5);
+
+    // Host counts that do not parse are errors, not defaults
+    for (const std::string bad : {"-1", "ten"}) {
+        write_file("bad.xml", R"(<?xml version="1.0"?>
+<experiments>
+    <experiment name="elastic">
+        <tasks>pool.csv</tasks>
+        <autoscaling min="1" max=")" + bad + R"(">
+            <cpu_cores>2</cpu_cores>
+            <ram>1000</ram>
+        </autoscaling>
+    </experiment>
+</experiments>)");
+        try {
+            parsers::load_experiments_from_xml(test_dir + "/bad.xml");
+            FAIL() << "max=\"" << bad << "\" was accepted";
+        } catch (const std::runtime_error& e) {
+            EXPECT_NE(std::string(e.what()).find("autoscaling max '" + bad + "' in experiment 'elastic'"),
+                      std::string::npos) << e.what();
+        }
+    }
+
+    // t=10 and t=20: tasks queued, a host is added each time (usable 5 later);
+    // t=220: POOL_1 is idle at a third of the cores busy and is drained
+    simulator::TaskSimulator sim(config, parsers::parse_tasks_csv(test_dir + "/pool.csv"));
+    sim.run();
+    const auto& records = sim.records();
+    const int64_t starts[] = {0, 0, 15, 15, 25, 25, 100, 100, 115, 115, 125, 125};
+    for (size_t i = 0; i < 12; ++i) {
+        EXPECT_EQ(records[i].start, starts[i]) << "T" << i;
+    }
+    EXPECT_EQ(sim.tasks()[2].host, "POOL_1");
+    EXPECT_EQ(sim.tasks()[4].host, "POOL_2");
+    EXPECT_EQ(records[2].cpu_wait, 15);
+    EXPECT_EQ(sim.makespan(), 225);
+
+    const auto& autoscaler = *sim.autoscaler();
+    EXPECT_EQ(autoscaler.scale_ups(), 2u);
+    EXPECT_EQ(autoscaler.scale_downs(), 1u);
+    EXPECT_EQ(autoscaler.peak_hosts(), 3u);
+    ASSERT_EQ(sim.hosts().size(), 3u);
+    EXPECT_EQ(sim.host_time(0), 225);
+    EXPECT_EQ(sim.host_time(1), 210);
+    EXPECT_EQ(sim.host_time(2), 205);
+    EXPECT_EQ(autoscaler.pool_host_time(sim.makespan()), 640);
+}
+
+TEST_F(EdgeCaseTest, PoolTasksReceiveOutputsOnTheirHost) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+    config.autoscaling.enabled = true;
+    config.autoscaling.host = models::HostConfig{2, 1000};
+    config.autoscaling.max_hosts = 2;
+
+    // src runs on the static host; P0 gets its output over a link created on
+    // first use, P1 follows P0 onto the same (least loaded) pool host
+    std::vector<models::Task> tasks = {
+        {"src", "HOST_0", 0, 10, 10, 5, {}, {}, 0, 0},
+        {"P0", "POOL", 0, 20, 10, 5, {"src"}, {}, 1, 0},
+        {"P1", "POOL", 0, 20, 10, 5, {"P0"}, {}, 2, 0},
+    };
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    sim.run();
+
+    const auto& records = sim.records();
+    EXPECT_EQ(sim.tasks()[1].host, "POOL_0");
+    EXPECT_EQ(records[1].ready, 15);
+    EXPECT_EQ(records[1].transfer, 5);
+    EXPECT_EQ(sim.tasks()[2].host, "POOL_0");
+    EXPECT_EQ(records[2].ready, 35);
+    EXPECT_EQ(sim.makespan(), 55);
+
+    simcpp20::simulation<> link_sim;
+    simulator::NetworkLink network(link_sim, 2);
+    EXPECT_EQ(network.num_links(), 0u);
+    auto* link = network.get_link(0, 1);
+    EXPECT_EQ(network.get_link(0, 1), link);
+    EXPECT_EQ(network.num_links(), 1u);
+    EXPECT_THROW(network.get_link(0, 2), std::runtime_error);
+    network.add_host();
+    EXPECT_NE(network.get_link(2, 0), nullptr);
+    EXPECT_THROW(network.get_link(1, 1), std::runtime_error);
+}
+
+// ============================================================================
+// Pipelined Dependencies
+// ============================================================================
+
+TEST_F(EdgeCaseTest, PipelinedConsumerOverlapsItsProducer) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{2, 1000};
+
+    // C starts with the first of 4 chunks (t=25) but its run of 30 ends
+    // before the producer does, so it holds its core until the last chunk
+    auto make_tasks = [](int chunks) {
+        return std::vector<models::Task>{
+            {"P", "HOST_0", 0, 100, 10, 0, {}, {}, 0, 0},
+            {"C", "HOST_0", 0, 30, 10, 0, {"P"}, {}, 1, 0, "", "", chunks},
+        };
+    };
+    simulator::TaskSimulator pipelined(config, make_tasks(4));
+    EXPECT_THROW(pipelined.set_quantum(10), std::invalid_argument);
+    pipelined.run();
+    EXPECT_EQ(pipelined.records()[1].start, 25);
+    EXPECT_EQ(pipelined.records()[1].finish, 100);
+    EXPECT_EQ(pipelined.makespan(), 100);
+
+    // One chunk is the plain dependency
+    simulator::TaskSimulator blocking(config, make_tasks(1));
+    blocking.run();
+    EXPECT_EQ(blocking.records()[1].start, 100);
+    EXPECT_EQ(blocking.makespan(), 130);
+
+    parsers::write_tasks_csv(test_dir + "/tasks.csv", make_tasks(4));
+    auto parsed = parsers::parse_tasks_csv(test_dir + "/tasks.csv");
+    EXPECT_EQ(parsed[0].pipeline_chunks, 0);
+    EXPECT_EQ(parsed[1].pipeline_chunks, 4);
+}
+
+TEST_F(EdgeCaseTest, PipelinedChunksShareTheLink) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+    config.hosts["HOST_1"] = models::HostConfig{1, 1000};
+
+    auto make_tasks = [](int network_time, int chunks) {
+        return std::vector<models::Task>{
+            {"P", "HOST_0", 0, 100, 10, network_time, {}, {}, 0, 0},
+            {"C", "HOST_1", 0, 10, 10, 0, {"P"}, {}, 1, 0, "", "", chunks},
+        };
+    };
+
+    // Chunks of 10 leave at 25, 50, 75 and 100: the last arrives at 110
+    simulator::TaskSimulator overlapped(config, make_tasks(40, 4));
+    overlapped.run();
+    EXPECT_EQ(overlapped.records()[1].start, 35);
+    EXPECT_EQ(overlapped.records()[1].finish, 110);
+
+    // Network-bound: the first chunk takes until 125, by then the other three
+    // are out and go over the link in one hold of 300
+    simulator::TaskSimulator backlogged(config, make_tasks(400, 4));
+    backlogged.run();
+    EXPECT_EQ(backlogged.records()[1].start, 125);
+    EXPECT_EQ(backlogged.records()[1].finish, 425);
+
+    simulator::TaskSimulator blocking(config, make_tasks(400, 0));
+    blocking.run();
+    EXPECT_EQ(blocking.records()[1].finish, 510);
+}
+
+// ============================================================================
+// Chain Coarsening
+// ============================================================================
+
+TEST_F(EdgeCaseTest, CoarsenedChainMatchesTaskByTaskRun) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+    config.hosts["HOST_1"] = models::HostConfig{1, 1000};
+
+    // HOST_0 runs one chain: src -> A -> B -> C, with B still sleeping when
+    // A finishes. On HOST_1 two chains share one core, so none coarsens.
+    auto make_tasks = [] {
+        return std::vector<models::Task>{
+            {"src", "HOST_1", 0, 5, 10, 7, {}, {}, 0, 0},
+            {"A", "HOST_0", 0, 10, 500, 0, {"src"}, {}, 1, 0},
+            {"B", "HOST_0", 30, 5, 800, 0, {"A"}, {}, 2, 0},
+            {"C", "HOST_0", 0, 5, 100, 0, {"B"}, {}, 3, 0},
+            {"X", "HOST_1", 0, 5, 10, 0, {}, {}, 4, 0},
+            {"Y", "HOST_1", 0, 5, 10, 0, {"X"}, {}, 5, 0},
+            {"Z", "HOST_1", 0, 5, 10, 0, {"Y"}, {}, 6, 0},
+        };
+    };
+
+    simulator::TaskSimulator reference(config, make_tasks());
+    reference.run();
+
+    simulator::TaskSimulator coarse(config, make_tasks());
+    coarse.enable_coarsening();
+    EXPECT_THROW(coarse.set_quantum(10), std::invalid_argument);
+    EXPECT_THROW(coarse.enable_task_rows(test_dir + "/rows.csv", simulator::TaskRowFormat::Csv),
+                 std::invalid_argument);
+    coarse.run();
+    EXPECT_EQ(coarse.coarsened_tasks(), 2u);
+    EXPECT_LT(coarse.counters().events.load(), reference.counters().events.load());
+    EXPECT_EQ(coarse.makespan(), reference.makespan());
+    EXPECT_EQ(coarse.counters().tasks_completed.load(), 7u);
+
+    for (size_t i = 0; i < reference.records().size(); ++i) {
+        const auto& expected = reference.records()[i];
+        const auto& actual = coarse.records()[i];
+        EXPECT_EQ(actual.ready, expected.ready) << i;
+        EXPECT_EQ(actual.start, expected.start) << i;
+        EXPECT_EQ(actual.finish, expected.finish) << i;
+        EXPECT_EQ(actual.dependency_wait, expected.dependency_wait) << i;
+        EXPECT_EQ(actual.phase, simulator::TaskPhase::Done) << i;
+    }
+    EXPECT_EQ(coarse.records()[2].start, 30);
+    EXPECT_EQ(coarse.records()[3].finish, 40);
+
+    // A second chain on HOST_0 can hold its only core
+    auto tasks = make_tasks();
+    tasks.push_back(models::Task{"W", "HOST_0", 0, 5, 10, 0, {}, {}, 7, 0});
+    simulator::TaskSimulator contended(config, std::move(tasks));
+    contended.enable_coarsening();
+    EXPECT_EQ(contended.coarsened_tasks(), 0u);
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+TEST_F(EdgeCaseTest, SampledRunEstimatesSteadyChains) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{2, 1000};
+    config.hosts["HOST_1"] = models::HostConfig{2, 1000};
+
+    // Four interleaved chains with varying run times, two per host
+    std::vector<models::Task> tasks;
+    for (size_t i = 0; i < 8000; ++i) {
+        std::vector<std::string> deps;
+        if (i >= 4) deps.push_back("T" + std::to_string(i - 4));
+        tasks.push_back(models::Task{"T" + std::to_string(i), "HOST_" + std::to_string(i % 2), 0,
+                                     static_cast<int>(5 + i * 7 % 11), 10, 0, deps, {}, i, 0});
+    }
+    simulator::TaskSimulator full(config, std::vector<models::Task>(tasks));
+    full.run();
+
+    simulator::WorkStealingPool pool(2);
+    auto run = simulator::run_sampled(config, tasks, simulator::SamplingConfig{200, 1000, 20}, pool);
+    EXPECT_EQ(run.tasks, 8000u);
+    EXPECT_EQ(run.windows, 8u);
+    EXPECT_EQ(run.detailed_tasks, 1600u);
+    EXPECT_LE(run.makespan.low, run.makespan.estimate);
+    EXPECT_GE(run.makespan.high, run.makespan.estimate);
+    EXPECT_NEAR(run.makespan.estimate, static_cast<double>(full.makespan()), 0.02 * full.makespan());
+    EXPECT_NEAR(run.utilization.estimate, 100.0, 1.0);
+
+    // A single window has no spread to report
+    auto single = simulator::run_sampled(config, tasks, simulator::SamplingConfig{200, 8000, 20}, pool);
+    EXPECT_EQ(single.windows, 1u);
+    EXPECT_EQ(single.makespan.low, single.makespan.high);
+}
+
+TEST_F(EdgeCaseTest, SampledRunRejectsInvalidSetups) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+    std::vector<models::Task> tasks = {
+        {"A", "HOST_0", 0, 5, 10, 0, {"B"}, {}, 0, 0},
+        {"B", "HOST_0", 0, 5, 10, 0, {}, {}, 1, 0},
+    };
+    simulator::WorkStealingPool pool(1);
+
+    EXPECT_THROW(simulator::SamplingConfig({0, 10, 0}).validate(), std::invalid_argument);
+    EXPECT_THROW(simulator::SamplingConfig({20, 10, 0}).validate(), std::invalid_argument);
+    EXPECT_THROW(simulator::SamplingConfig({10, 100, 5}).validate(), std::invalid_argument);
+    // Slices are cut in file order, so dependencies must point backwards
+    EXPECT_THROW(simulator::run_sampled(config, tasks, simulator::SamplingConfig{2, 2, 0}, pool),
+                 std::invalid_argument);
+    // Too few tasks to get past the warm-up
+    tasks[0].dependencies.clear();
+    tasks[1].dependencies = {"A"};
+    EXPECT_THROW(simulator::run_sampled(config, tasks, simulator::SamplingConfig{10, 10, 1}, pool),
+                 std::invalid_argument);
+}
+
+// ============================================================================
+// Calibration
+// ============================================================================
+
+TEST_F(EdgeCaseTest, LinkScalesSlowTransfersPerDirection) {
+    models::ExperimentConfig config;
+    config.tasks_csv_path = "generated";
+    config.hosts["HOST_0"] = models::HostConfig{1, 1000};
+    config.hosts["HOST_1"] = models::HostConfig{1, 1000};
+    config.link_scales.push_back(models::LinkScale{"HOST_0", "HOST_1", 2.5});
+    std::vector<models::Task> tasks = {
+        {"A", "HOST_0", 0, 10, 10, 8, {}, {}, 0, 0},
+        {"B", "HOST_1", 0, 10, 10, 8, {"A"}, {}, 1, 0},
+        {"C", "HOST_0", 0, 10, 10, 0, {"B"}, {}, 2, 0},
+    };
+    simulator::TaskSimulator sim(config, std::move(tasks));
+    sim.run();
+    // A -> B takes 8 * 2.5, B -> C the unscaled 8
+    EXPECT_EQ(sim.records()[1].start, 30);
+    EXPECT_EQ(sim.records()[2].start, 48);
+
+    config.hosts["HOST_0"].cpu_cores = 2;
+    config.link_scales.push_back(models::LinkScale{"HOST_0", "HOST_0", 2.0});
+    EXPECT_THROW(config.validate(), std::invalid_argument);
+}
+
+TEST_F(EdgeCaseTest, CalibrationRecoversSpeedsAndLinkScales) {
+    models::ExperimentConfig truth;
+    truth.tasks_csv_path = "generated";
+    truth.hosts["HOST_0"] = models::HostConfig{2, 1000, 1.5};
+    truth.hosts["HOST_1"] = models::HostConfig{2, 1000, 0.8};
+    truth.link_scales = {{"HOST_0", "HOST_1", 2.0}, {"HOST_1", "HOST_0", 0.5}};
+
+    // Two chains alternating between the hosts
+    std::vector<models::Task> tasks;
+    for (size_t i = 0; i < 80; ++i) {
+        std::vector<std::string> deps;
+        if (i >= 2) deps.push_back("T" + std::to_string(i - 2));
+        tasks.push_back(models::Task{"T" + std::to_string(i), "HOST_" + std::to_string(i / 2 % 2), 0,
+                                     static_cast<int>(60 + i * 13 % 17), 10,
+                                     static_cast<int>(30 + i % 7), deps, {}, i, 0});
+    }
+    simulator::TaskSimulator actual(truth, std::vector<models::Task>(tasks));
+    actual.run();
+
+    // The log's clock starts elsewhere and one row names an unknown task
+    std::vector<simulator::ObservedTask> observed;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        observed.push_back({tasks[i].name, 5000 + actual.records()[i].start, 5000 + actual.records()[i].finish});
+    }
+    observed.push_back({"OTHER", 5000, 5010});
+
+    models::ExperimentConfig nominal = truth;
+    nominal.hosts["HOST_0"].speed = 1.0;
+    nominal.hosts["HOST_1"].speed = 1.0;
+    nominal.link_scales.clear();
+
+    simulator::WorkStealingPool pool(2);
+    auto calibration = simulator::calibrate(nominal, tasks, observed, simulator::CalibrationOptions{}, pool);
+    EXPECT_EQ(calibration.matched_tasks, 80u);
+    EXPECT_EQ(calibration.unmatched_observations, 1u);
+    ASSERT_EQ(calibration.hosts.size(), 2u);
+    EXPECT_NEAR(calibration.hosts[0].speed_after, 1.5, 0.03);
+    EXPECT_NEAR(calibration.hosts[1].speed_after, 0.8, 0.02);
+    ASSERT_EQ(calibration.links.size(), 2u);
+    EXPECT_EQ(calibration.links[0].from, "HOST_0");
+    EXPECT_NEAR(calibration.links[0].scale_after, 2.0, 0.1);
+    EXPECT_NEAR(calibration.links[1].scale_after, 0.5, 0.05);
+    EXPECT_LT(calibration.after.finish_rmse, 0.1 * calibration.before.finish_rmse);
+    EXPECT_NEAR(static_cast<double>(calibration.after.makespan_simulated),
+                static_cast<double>(actual.makespan()), 0.01 * actual.makespan());
+    EXPECT_EQ(calibration.residuals.size(), 80u);
+
+    // Result files can serve as logs
+    std::string log = test_dir + "/observed.result";
+    write_file("observed.result", "# task_simulator result v1\nMAKESPAN,30\n"
+               "TASK_NAME,TASK_HOST,READY,START,FINISH,CRITICAL\nT0,HOST_0,0,0,30,1\nT1,HOST_0,0,5,20,0\n");
+    auto parsed = simulator::parse_observed_log(log);
+    ASSERT_EQ(parsed.size(), 2u);
+    EXPECT_EQ(parsed[1].name, "T1");
+    EXPECT_EQ(parsed[1].start, 5);
+    EXPECT_EQ(parsed[1].finish, 20);
+    write_file("bad.csv", "TASK_NAME,START,FINISH\nT0,10,5\n");
+    EXPECT_THROW(simulator::parse_observed_log(test_dir + "/bad.csv"), std::runtime_error);
+}
+
+// ============================================================================
+// Core Semaphore
+// ============================================================================
+
+static simcpp20::process<> hold_core(simcpp20::simulation<>& sim, simcpp20::semaphore<>& cores,
+                                     int64_t duration, std::vector<std::pair<int, int64_t>>& grants, int id) {
+    auto core = co_await cores.acquire();
+    grants.emplace_back(id, static_cast<int64_t>(sim.now()));
+    co_await sim.timeout(duration);
+}
+
+TEST_F(EdgeCaseTest, CoreSemaphoreGrantsInArrivalOrder) {
+    simcpp20::simulation<> sim;
+    simcpp20::semaphore<> cores(sim, 2);
+    std::vector<std::pair<int, int64_t>> grants;
+
+    hold_core(sim, cores, 10, grants, 0);
+    hold_core(sim, cores, 5, grants, 1);
+    sim.run_until(1);
+    EXPECT_EQ(cores.available(), 0u);
+
+    // Queue: a request that is withdrawn, 2, a request, 3
+    auto withdrawn = cores.request();
+    hold_core(sim, cores, 1, grants, 2);
+    sim.run_until(2);
+    auto queued = cores.request();
+    hold_core(sim, cores, 1, grants, 3);
+    sim.run_until(3);
+    withdrawn.abort();
+    sim.run_until(7);
+
+    // 2 takes the core 1 released at 5, the request the one 2 released at 6
+    EXPECT_TRUE(queued.processed());
+    EXPECT_EQ(grants, (std::vector<std::pair<int, int64_t>>{{0, 0}, {1, 0}, {2, 5}}));
+    cores.release();
+    sim.run();
+    EXPECT_EQ(grants.back(), (std::pair<int, int64_t>{3, 7}));
+    EXPECT_EQ(cores.available(), 2u);
+
+    // A hold gives its unit back once, however it ends
+    {
+        EXPECT_TRUE(cores.try_acquire());
+        simcpp20::semaphore<>::hold held(cores);
+        auto moved = std::move(held);
+        EXPECT_FALSE(held);
+        moved.release();
+        EXPECT_EQ(cores.available(), 2u);
+    }
+    EXPECT_EQ(cores.available(), 2u);
+}
+
+// ============================================================================
+// Link Clock
+// ============================================================================
+
+TEST_F(EdgeCaseTest, LinkClockMatchesResourceLinks) {
+    write_file("config.xml", R"(<?xml version="1.0"?>
+<experiments>
+    <experiment name="clocked">
+        <tasks>links.csv</tasks>
+        <host id="HOST_0"><cpu_cores>4</cpu_cores><ram>1000</ram></host>
+        <host id="HOST_1"><cpu_cores>1</cpu_cores><ram>1000</ram></host>
+        <network links="clock"/>
+    </experiment>
+</experiments>)");
+    auto clock_config = parsers::get_experiment_config(
+        parsers::load_experiments_from_xml(test_dir + "/config.xml"), "clocked");
+    ASSERT_EQ(clock_config.link_model, models::LinkModel::Clock);
+    auto resource_config = clock_config;
+    resource_config.link_model = models::LinkModel::Resource;
+
+    // A's output holds the link over [10, 30), B's queues behind it until
+    // 50 and C's until 55; HOST_1's single core then serializes X, Y and Z
+    auto make_tasks = [] {
+        return std::vector<models::Task>{
+            {"A", "HOST_0", 0, 10, 10, 20, {}, {}, 0, 0},
+            {"B", "HOST_0", 0, 12, 10, 20, {}, {}, 1, 0},
+            {"C", "HOST_0", 0, 31, 10, 5, {}, {}, 2, 0},
+            {"X", "HOST_1", 0, 10, 10, 0, {"A"}, {}, 3, 0},
+            {"Y", "HOST_1", 0, 10, 10, 0, {"B"}, {}, 4, 0},
+            {"Z", "HOST_1", 0, 10, 10, 0, {"C"}, {}, 5, 0},
+        };
+    };
+
+    simulator::TaskSimulator resource(resource_config, make_tasks());
+    resource.run();
+    simulator::TaskSimulator clock(clock_config, make_tasks());
+    EXPECT_THROW(clock.set_quantum(10), std::invalid_argument);
+    EXPECT_THROW(clock.enable_timeseries(), std::invalid_argument);
+    clock.run();
+
+    EXPECT_EQ(clock.makespan(), 70);
+    EXPECT_EQ(clock.makespan(), resource.makespan());
+    EXPECT_LT(clock.counters().events.load(), resource.counters().events.load());
+    for (size_t i = 0; i < resource.records().size(); ++i) {
+        const auto& expected = resource.records()[i];
+        const auto& actual = clock.records()[i];
+        EXPECT_EQ(actual.ready, expected.ready) << i;
+        EXPECT_EQ(actual.start, expected.start) << i;
+        EXPECT_EQ(actual.finish, expected.finish) << i;
+        EXPECT_EQ(actual.link_wait, expected.link_wait) << i;
+        EXPECT_EQ(actual.transfer, expected.transfer) << i;
+    }
+    EXPECT_EQ(clock.records()[4].link_wait, 18);
+    EXPECT_EQ(clock.records()[5].ready, 55);
+    EXPECT_EQ(clock.records()[5].start, 60);
+
+    // The clock times a pipelined consumer's chunks only when the link frees
+    auto tasks = make_tasks();
+    tasks[3].pipeline_chunks = 4;
+    EXPECT_THROW(simulator::TaskSimulator(clock_config, std::move(tasks)), std::invalid_argument);
+
+    // Two transfers on 0 -> 1 queue, the one on 1 -> 0 does not
+    simcpp20::simulation<> link_sim;
+    simulator::NetworkLink network(link_sim, 2, models::LinkModel::Clock);
+    std::vector<std::pair<int64_t, int64_t>> transfers;  // (start, end)
+    auto send = [&](simcpp20::simulation<>& sim, size_t from, size_t to) -> simcpp20::process<> {
+        int64_t start = co_await network.transfer(from, to, 5);
+        transfers.emplace_back(start, static_cast<int64_t>(sim.now()));
+    };
+    send(link_sim, 0, 1);
+    send(link_sim, 0, 1);
+    send(link_sim, 1, 0);
+    link_sim.run();
+    ASSERT_EQ(transfers.size(), 3u);
+    EXPECT_EQ(transfers[0], std::make_pair(int64_t{0}, int64_t{5}));
+    EXPECT_EQ(transfers[1], std::make_pair(int64_t{0}, int64_t{5}));
+    EXPECT_EQ(transfers[2], std::make_pair(int64_t{5}, int64_t{10}));
+    EXPECT_FALSE(network.busy(0, 1));
+    EXPECT_EQ(network.num_links(), 2u);
+    EXPECT_THROW(network.transfer(1, 1, 5), std::runtime_error);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -2,6 +2,14 @@
 #include "../include/simulator.hpp"
 #include "../include/models.h"
 #include "../include/logger.hpp"
+#include "../include/executor.hpp"
+#include "../include/lockstep.hpp"
+#include "../include/config_parser.h"
+#include "../include/csv_parser.h"
+#include "../include/workloads.h"
+#include <algorithm>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <string>
 
@@ -83,23 +91,281 @@ TEST_F(PerformanceTest, PingPong_10000_Tasks_50_Hosts) {
     auto config = generate_config(50);
     auto tasks = generate_ping_pong_tasks(10000, 50);
 
-    simulator::TaskSimulator sim;
+    auto sim = std::make_unique<simulator::TaskSimulator>();
 
     EXPECT_NO_THROW(measure_time("Initialization", [&]() {
-        sim.init(config, std::move(tasks));
+        sim->init(config, std::move(tasks));
     }));
 
-    EXPECT_NO_THROW(sim.run());
+    EXPECT_NO_THROW(sim->run());
+
+    measure_time("Teardown", [&]() {
+        sim.reset();
+    });
 }
 
 TEST_F(PerformanceTest, DISABLED_PingPong_1M_Tasks_100_Hosts) {
     auto config = generate_config(100);
     auto tasks = generate_ping_pong_tasks(1000000, 100);
 
-    simulator::TaskSimulator sim;
+    auto sim = std::make_unique<simulator::TaskSimulator>();
     EXPECT_NO_THROW(measure_time("Initialization", [&]() {
-        sim.init(config, std::move(tasks));
+        sim->init(config, std::move(tasks));
     }));
 
-    EXPECT_NO_THROW(sim.run());
+    EXPECT_NO_THROW(measure_time("Simulation", [&]() {
+        sim->run();
+    }));
+
+    measure_time("Teardown", [&]() {
+        sim.reset();
+    });
+}
+
+// Batch of the shipped experiments (replicated) mixed with generated
+// workloads a thousand times larger, as a sweep would produce. Static
+// partitioning leaves workers idle behind whichever got the large runs;
+// the work-stealing pool should finish close to the longest single run.
+TEST_F(PerformanceTest, WorkStealing_MixedBatch) {
+    struct Job {
+        std::string name;
+        models::ExperimentConfig config;
+        std::vector<models::Task> tasks;
+    };
+    std::vector<Job> jobs;
+    const std::pair<workloads::Kind, size_t> generated[] = {
+        {workloads::Kind::FanOut, 200000}, {workloads::Kind::PingPong, 100000},
+        {workloads::Kind::RamContended, 50000}, {workloads::Kind::Chain, 50000}};
+    for (const auto& [kind, num_tasks] : generated) {
+        jobs.push_back({workloads::kind_name(kind), workloads::generate_config(16),
+                        workloads::generate_tasks(kind, num_tasks, 16)});
+    }
+    auto experiments = parsers::load_experiments_from_xml(TASK_SIMULATOR_DATA_DIR "/experiments.xml");
+    for (int replication = 0; replication < 8; ++replication) {
+        for (const auto& [name, config] : experiments) {
+            jobs.push_back({name, config, parsers::parse_tasks_csv(config.tasks_csv_path)});
+        }
+    }
+
+    auto run_job = [&jobs](size_t i) {
+        auto tasks = jobs[i].tasks;
+        simulator::TaskSimulator sim(jobs[i].config, std::move(tasks));
+        sim.run();
+        return sim.makespan();
+    };
+
+    logger::set_level(spdlog::level::warn);
+    const size_t num_threads = 4;
+
+    // Static partitioning: job i on thread i % num_threads
+    std::vector<int64_t> static_makespans(jobs.size());
+    std::vector<int64_t> static_busy(num_threads);
+    auto static_us = measure_time("Static partitioning", [&]() {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                auto started = std::chrono::steady_clock::now();
+                for (size_t i = t; i < jobs.size(); i += num_threads) {
+                    static_makespans[i] = run_job(i);
+                }
+                static_busy[t] = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - started).count();
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+
+    simulator::WorkStealingPool pool(num_threads);
+    std::vector<int64_t> makespans;
+    auto stealing_us = measure_time("Work stealing", [&]() {
+        makespans = pool.map<int64_t>(jobs.size(), run_job);
+    });
+    logger::set_level(spdlog::level::info);
+
+    // Same runs, same order, same results
+    EXPECT_EQ(makespans, static_makespans);
+
+    auto imbalance = [](const std::vector<double>& busy) {
+        double sum = 0.0;
+        for (double b : busy) sum += b;
+        return *std::max_element(busy.begin(), busy.end()) / (sum / busy.size());
+    };
+    std::vector<double> pool_busy;
+    uint64_t steals = 0;
+    for (const auto& worker : pool.stats()) {
+        pool_busy.push_back(static_cast<double>(worker.busy.count()));
+        steals += worker.steals;
+    }
+    logger::info("{} jobs on {} threads: static {} us (busiest {:.2f}x average), "
+                 "work stealing {} us (busiest {:.2f}x average, {} steals)",
+                 jobs.size(), num_threads, static_us,
+                 imbalance(std::vector<double>(static_busy.begin(), static_busy.end())),
+                 stealing_us, imbalance(pool_busy), steals);
+}
+
+// Cores as a generic resource: every request is an event
+static simcpp20::process<> resource_worker(simcpp20::simulation<>& sim, simcpp20::resource<>& cores,
+                                           int rounds, uint64_t& grants) {
+    for (int i = 0; i < rounds; ++i) {
+        auto request = cores.request();
+        co_await request;
+        ++grants;
+        co_await sim.timeout(1);
+        cores.release();
+    }
+}
+
+// Cores as a semaphore: free cores are granted without an event
+static simcpp20::process<> semaphore_worker(simcpp20::simulation<>& sim, simcpp20::semaphore<>& cores,
+                                            int rounds, uint64_t& grants) {
+    for (int i = 0; i < rounds; ++i) {
+        auto core = co_await cores.acquire();
+        ++grants;
+        co_await sim.timeout(1);
+    }
+}
+
+// Grants per second of both core resources, with a core for every worker
+// and with 16 workers per core
+TEST_F(PerformanceTest, CoreSemaphore_GrantsPerSecond) {
+    const int workers = 64;
+    const int rounds = 20000;
+    for (uint64_t num_cores : {64u, 4u}) {
+        uint64_t resource_grants = 0;
+        uint64_t semaphore_grants = 0;
+        auto resource_us = measure_time("Resource", [&]() {
+            simcpp20::simulation<> sim;
+            simcpp20::resource<> cores(sim, num_cores);
+            for (int w = 0; w < workers; ++w) resource_worker(sim, cores, rounds, resource_grants);
+            sim.run();
+        });
+        auto semaphore_us = measure_time("Semaphore", [&]() {
+            simcpp20::simulation<> sim;
+            simcpp20::semaphore<> cores(sim, num_cores);
+            for (int w = 0; w < workers; ++w) semaphore_worker(sim, cores, rounds, semaphore_grants);
+            sim.run();
+            EXPECT_EQ(cores.available(), num_cores);
+        });
+
+        EXPECT_EQ(resource_grants, static_cast<uint64_t>(workers) * rounds);
+        EXPECT_EQ(semaphore_grants, resource_grants);
+        auto rate = [](uint64_t grants, int64_t us) { return static_cast<double>(grants) / std::max<int64_t>(us, 1); };
+        logger::info("{} cores, {} workers: resource {:.2f}M grants/s, semaphore {:.2f}M grants/s",
+                     num_cores, workers, rate(resource_grants, resource_us), rate(semaphore_grants, semaphore_us));
+    }
+}
+
+// Generated chain workload: one same-host chain per host, each ending in a
+// sink, so every host coarsens to a head task plus one macro-task
+TEST_F(PerformanceTest, Coarsening_Chain_100000_Tasks_10_Hosts) {
+    auto config = generate_config(10);
+    auto run = [&](bool coarsen, uint64_t& events) {
+        simulator::TaskSimulator sim(config, workloads::generate_tasks(workloads::Kind::Chain, 100000, 10));
+        if (coarsen) sim.enable_coarsening();
+        sim.run();
+        events = sim.counters().events.load();
+        return sim.records();
+    };
+
+    logger::set_level(spdlog::level::warn);
+    uint64_t plain_events = 0;
+    uint64_t coarse_events = 0;
+    std::vector<simulator::TaskRecord> plain;
+    std::vector<simulator::TaskRecord> coarse;
+    auto plain_us = measure_time("Task by task", [&]() { plain = run(false, plain_events); });
+    auto coarse_us = measure_time("Coarsened", [&]() { coarse = run(true, coarse_events); });
+    logger::set_level(spdlog::level::info);
+
+    ASSERT_EQ(plain.size(), coarse.size());
+    for (size_t i = 0; i < plain.size(); ++i) {
+        ASSERT_EQ(plain[i].start, coarse[i].start) << i;
+        ASSERT_EQ(plain[i].finish, coarse[i].finish) << i;
+    }
+    EXPECT_LT(coarse_events * 100, plain_events);
+    logger::info("Task by task {} us ({} events), coarsened {} us ({} events)",
+                 plain_us, plain_events, coarse_us, coarse_events);
+}
+
+// Ping-pong and fan-out workloads: every task's input crosses a link. Link
+// clocks drop the request event of each transfer that finds its link free
+// and must give the identical schedule
+TEST_F(PerformanceTest, LinkClock_100000_Tasks_10_Hosts) {
+    for (auto kind : {workloads::Kind::PingPong, workloads::Kind::FanOut}) {
+        auto tasks = workloads::generate_tasks(kind, 100000, 10);
+        auto run = [&](models::LinkModel model, uint64_t& events, std::vector<simulator::TaskRecord>& records) {
+            auto config = generate_config(10);
+            config.link_model = model;
+            simulator::TaskSimulator sim(config, std::vector<models::Task>(tasks));
+            sim.run();
+            events = sim.counters().events.load();
+            records = sim.records();
+            return sim.makespan();
+        };
+
+        logger::set_level(spdlog::level::warn);
+        uint64_t resource_events = 0;
+        uint64_t clock_events = 0;
+        int64_t resource_makespan = 0;
+        int64_t clock_makespan = 0;
+        std::vector<simulator::TaskRecord> resource_records;
+        std::vector<simulator::TaskRecord> clock_records;
+        auto resource_us = measure_time("Resource links", [&]() {
+            resource_makespan = run(models::LinkModel::Resource, resource_events, resource_records);
+        });
+        auto clock_us = measure_time("Link clocks", [&]() {
+            clock_makespan = run(models::LinkModel::Clock, clock_events, clock_records);
+        });
+        logger::set_level(spdlog::level::info);
+
+        EXPECT_EQ(clock_makespan, resource_makespan);
+        ASSERT_EQ(clock_records.size(), resource_records.size());
+        for (size_t i = 0; i < resource_records.size(); ++i) {
+            ASSERT_EQ(clock_records[i].ready, resource_records[i].ready) << i;
+            ASSERT_EQ(clock_records[i].start, resource_records[i].start) << i;
+            ASSERT_EQ(clock_records[i].finish, resource_records[i].finish) << i;
+        }
+        EXPECT_LT(clock_events, resource_events);
+        logger::info("{}: resource links {} us ({} events, makespan {}), link clocks {} us ({} events, makespan {})",
+                     workloads::kind_name(kind), resource_us, resource_events, resource_makespan,
+                     clock_us, clock_events, clock_makespan);
+    }
+}
+
+// Replications of one workload under different straggler seeds: one engine
+// run per group of lanes fixes the grant order, the lanes replay it together
+TEST_F(PerformanceTest, Lockstep_PingPong_10000_Tasks_64_Replications) {
+    auto config = generate_config(10);
+    config.stragglers.probability = 0.05;
+    config.stragglers.distribution = models::SlowdownDistribution::Uniform;
+    config.stragglers.min = 1.5;
+    config.stragglers.max = 3.0;
+    auto tasks = generate_ping_pong_tasks(10000, 10);
+    constexpr size_t replications = 64;
+
+    logger::set_level(spdlog::level::warn);
+    std::vector<int64_t> engine_makespans;
+    auto engine_us = measure_time("Engine replications", [&]() {
+        for (size_t r = 0; r < replications; ++r) {
+            auto seeded = config;
+            seeded.stragglers.seed += r;
+            simulator::TaskSimulator sim(seeded, std::vector<models::Task>(tasks));
+            sim.run();
+            engine_makespans.push_back(sim.makespan());
+        }
+    });
+    std::vector<simulator::Replication> replicated;
+    auto lockstep_us = measure_time("Lockstep replications", [&]() {
+        replicated = simulator::run_lockstep(config, tasks, replications);
+    });
+    logger::set_level(spdlog::level::info);
+
+    ASSERT_EQ(replicated.size(), replications);
+    size_t replayed = 0;
+    for (size_t r = 0; r < replications; ++r) {
+        EXPECT_EQ(replicated[r].makespan, engine_makespans[r]) << r;
+        replayed += replicated[r].lockstep;
+    }
+    EXPECT_GT(replayed, 0u);
+    logger::info("Engine {} us, lockstep {} us ({} of {} replications replayed)",
+                 engine_us, lockstep_us, replayed, replications);
 }